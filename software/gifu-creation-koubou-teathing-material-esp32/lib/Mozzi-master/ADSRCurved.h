@@ -0,0 +1,338 @@
+/*
+ * ADSRCurved.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef ADSRCURVED_H_
+#define ADSRCURVED_H_
+
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "Line.h"
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "tables/expcurve256_uint16.h"
+
+/** Curve shapes for the segments of ADSRCurved. */
+enum ADSRCurveShape {
+  ADSR_CURVE_LINEAR,  /**< a straight line, like ADSR */
+  ADSR_CURVE_EXP,     /**< moves fast at the start and settles slowly into the target, like an analog (RC) envelope */
+  ADSR_CURVE_LOG      /**< starts slowly and speeds up towards the target */
+};
+
+/** An ADSR envelope generator with a curve shape for each of the attack, decay and release segments.
+It is used like ADSR, with update() in updateControl() and next() in updateAudio().
+
+The curve is looked up from EXPCURVE256_DATA (with linear interpolation) once per update(), and next()
+interpolates linearly between those control points. So next() costs exactly the same as ADSR::next(),
+and the curve is resolved within the resolution of CONTROL_UPDATE_RATE: a 100ms decay at a CONTROL_RATE
+of 64 is drawn with about 6 straight pieces.
+@tparam CONTROL_UPDATE_RATE The frequency of control updates, see ADSR.
+@tparam LERP_RATE Sets how often next() will be called, see ADSR.
+*/
+template <unsigned int CONTROL_UPDATE_RATE, unsigned int LERP_RATE, typename T = unsigned int>
+class ADSRCurved {
+ private:
+  const unsigned int LERPS_PER_CONTROL;
+
+  T update_step_counter;
+  T num_update_steps;
+
+  enum { ATTACK,
+         DECAY,
+         SUSTAIN,
+         RELEASE,
+         IDLE };
+
+  struct phase {
+    byte phase_type;
+    T update_steps;
+    Q8n0 level;
+    byte curve;
+  } attack, decay, sustain, release, idle;
+
+  phase* current_phase;
+
+  Line<Q15n16> transition;  // scale up unsigned char levels for better accuracy, then scale down again for output
+  Q15n16 segment_start;     // level where the current phase started
+  Q15n16 last_target;       // level transition is heading to at the next update()
+
+  inline T convertMsecToControlUpdateSteps(unsigned int msec) {
+    return (T)(((uint32_t)msec * CONTROL_UPDATE_RATE) >> 10);  // approximate /1000 with shift
+  }
+
+  /* progress 0 to 65536 -> shaped 0 to 65536 */
+  static inline uint32_t shape(byte curve, uint32_t progress) {
+    if (progress >= 65536) return 65536;
+    switch (curve) {
+      case ADSR_CURVE_EXP:
+        return lookupCurve(progress);
+      case ADSR_CURVE_LOG:
+        return 65536 - lookupCurve(65536 - progress);
+      default:
+        return progress;
+    }
+  }
+
+  static inline uint32_t lookupCurve(uint32_t progress) {
+    const unsigned int index = progress >> 8;
+    const uint32_t fraction = progress & 0xff;
+    const uint32_t a = FLASH_OR_RAM_READ<const uint16_t>(EXPCURVE256_DATA + index);
+    const uint32_t b = FLASH_OR_RAM_READ<const uint16_t>(EXPCURVE256_DATA + index + 1);
+    return a + (((b - a) * fraction) >> 8);
+  }
+
+  /* sets the transition to the curve point at the end of the current update step */
+  inline void setNextControlPoint() {
+    const Q15n16 target = Q8n0_to_Q15n16(current_phase->level);
+    if (num_update_steps == 0) {
+      last_target = target;
+      transition.set(target, (Q15n16)0);
+      return;
+    }
+    const uint32_t progress = ((uint64_t)(update_step_counter + 1) << 16) / num_update_steps;
+    const int64_t distance = (int64_t)target - segment_start;
+    last_target = segment_start + (Q15n16)((distance * shape(current_phase->curve, progress)) >> 16);
+    transition.set(last_target, (Q15n16)LERPS_PER_CONTROL);
+  }
+
+  inline void setPhase(phase* next_phase) {
+    update_step_counter = 0;
+    num_update_steps = next_phase->update_steps;
+    current_phase = next_phase;
+    segment_start = last_target;
+    setNextControlPoint();
+  }
+
+  inline void checkForAndSetNextPhase(phase* next_phase) {
+    if (++update_step_counter >= num_update_steps) {
+      setPhase(next_phase);
+    } else {
+      setNextControlPoint();
+    }
+  }
+
+  inline void setTime(phase* p, unsigned int msec) {
+    p->update_steps = convertMsecToControlUpdateSteps(msec);
+  }
+
+ public:
+  /** Constructor.
+	 */
+  ADSRCurved() : LERPS_PER_CONTROL(LERP_RATE / CONTROL_UPDATE_RATE) {
+    attack.phase_type = ATTACK;
+    decay.phase_type = DECAY;
+    sustain.phase_type = SUSTAIN;
+    release.phase_type = RELEASE;
+    idle.phase_type = IDLE;
+    attack.curve = decay.curve = sustain.curve = release.curve = idle.curve = ADSR_CURVE_LINEAR;
+    release.level = 0;
+    idle.level = 0;
+    segment_start = last_target = 0;
+    transition.set(0);
+    adsr_playing = false;
+    current_phase = &idle;
+  }
+
+  /** Updates the internal controls of the ADSR.
+		Call this in updateControl().
+		*/
+  void update() {  // control rate
+
+    switch (current_phase->phase_type) {
+      case ATTACK:
+        checkForAndSetNextPhase(&decay);
+        break;
+
+      case DECAY:
+        checkForAndSetNextPhase(&sustain);
+        break;
+
+      case SUSTAIN:
+        checkForAndSetNextPhase(&release);
+        break;
+
+      case RELEASE:
+        checkForAndSetNextPhase(&idle);
+        break;
+
+      case IDLE:
+        adsr_playing = false;
+        break;
+    }
+  }
+
+  /** Advances one audio step along the ADSR and returns the level.
+	Call this in updateAudio().
+	@return the next value, as an unsigned char.
+	 */
+  inline unsigned char next() {
+    unsigned char out = 0;
+    if (adsr_playing) out = Q15n16_to_Q8n0(transition.next());
+    return out;
+  }
+
+  /** Advances n audio steps along the ADSR, for block based rendering.
+	@param out receives the n levels.
+	@param n the number of steps, at most LERP_RATE / CONTROL_UPDATE_RATE to stay between two update() calls.
+	 */
+  inline void next(uint8_t* out, unsigned int n) {
+    if (!adsr_playing) {
+      memset(out, 0, n);
+      return;
+    }
+    for (unsigned int i = 0; i < n; ++i) {
+      out[i] = Q15n16_to_Q8n0(transition.next());
+    }
+  }
+
+  /** Start the attack phase of the ADSR.  This will restart the ADSR no matter what phase it is up to.
+	@param reset If true, the envelope will start from 0, even if it is still playing.
+	If false (default if omitted), the envelope will start rising from the current level.
+	*/
+  inline void noteOn(bool reset = false) {
+    if (reset) {
+      transition.set(0);
+      last_target = 0;
+    }
+    setPhase(&attack);
+    adsr_playing = true;
+  }
+
+  /** Start the release phase of the ADSR.
+	*/
+  inline void noteOff() {
+    setPhase(&release);
+  }
+
+  /** Set the attack level of the ADSR.
+	@param value the attack level.
+	 */
+  inline void setAttackLevel(byte value) {
+    attack.level = value;
+  }
+
+  /** Set the decay level of the ADSR.
+	@param value the decay level.
+	*/
+  inline void setDecayLevel(byte value) {
+    decay.level = value;
+  }
+
+  /** Set the sustain level of the ADSR.
+	@param value the sustain level.  Usually the same as the decay level,
+	for a steady sustained note.
+	*/
+  inline void setSustainLevel(byte value) {
+    sustain.level = value;
+  }
+
+  /** Set the release level of the ADSR.  Normally you'd make this 0,
+	but you have the option of some other value.
+	@param value the release level (usually 0).
+	*/
+  inline void setReleaseLevel(byte value) {
+    release.level = value;
+  }
+
+  inline void setIdleLevel(byte value) {
+    idle.level = value;
+  }
+
+  /** Set the attack, decay, sustain and release levels.
+	*/
+  inline void setLevels(byte attack, byte decay, byte sustain, byte release) {
+    setAttackLevel(attack);
+    setDecayLevel(decay);
+    setSustainLevel(sustain);
+    setReleaseLevel(release);
+    setIdleLevel(0);
+  }
+
+  /** Set the attack time of the ADSR in milliseconds.
+	The actual time taken will be resolved within the resolution of CONTROL_RATE.
+	 */
+  inline void setAttackTime(unsigned int msec) {
+    setTime(&attack, msec);
+  }
+
+  /** Set the decay time of the ADSR in milliseconds.
+	*/
+  inline void setDecayTime(unsigned int msec) {
+    setTime(&decay, msec);
+  }
+
+  /** Set the sustain time of the ADSR in milliseconds.
+	The sustain phase will finish if the ADSR recieves a noteOff().
+	*/
+  inline void setSustainTime(unsigned int msec) {
+    setTime(&sustain, msec);
+  }
+
+  /** Set the release time of the ADSR in milliseconds.
+	*/
+  inline void setReleaseTime(unsigned int msec) {
+    setTime(&release, msec);
+  }
+
+  inline void setIdleTime(unsigned int msec) {
+    setTime(&idle, msec);
+  }
+
+  /** Set the attack, decay, sustain and release times of the ADSR in milliseconds.
+	*/
+  inline void setTimes(unsigned int attack_ms, unsigned int decay_ms, unsigned int sustain_ms, unsigned int release_ms) {
+    setAttackTime(attack_ms);
+    setDecayTime(decay_ms);
+    setSustainTime(sustain_ms);
+    setReleaseTime(release_ms);
+    setIdleTime(65535);
+  }
+
+  /** Set the curve of the attack segment.
+	@param curve one of ADSR_CURVE_LINEAR, ADSR_CURVE_EXP or ADSR_CURVE_LOG.
+	*/
+  inline void setAttackCurve(byte curve) {
+    attack.curve = curve;
+  }
+
+  /** Set the curve of the decay segment.
+	@param curve one of ADSR_CURVE_LINEAR, ADSR_CURVE_EXP or ADSR_CURVE_LOG.
+	*/
+  inline void setDecayCurve(byte curve) {
+    decay.curve = curve;
+  }
+
+  /** Set the curve of the release segment.
+	@param curve one of ADSR_CURVE_LINEAR, ADSR_CURVE_EXP or ADSR_CURVE_LOG.
+	*/
+  inline void setReleaseCurve(byte curve) {
+    release.curve = curve;
+  }
+
+  /** Set the curves of the attack, decay and release segments.
+	*/
+  inline void setCurves(byte attack_curve, byte decay_curve, byte release_curve) {
+    setAttackCurve(attack_curve);
+    setDecayCurve(decay_curve);
+    setReleaseCurve(release_curve);
+  }
+
+  bool adsr_playing;
+
+  /** Tells if the envelope is currently playing.
+	@return true if playing, false if in IDLE state
+	*/
+  inline bool playing() {
+    return adsr_playing;
+  }
+};
+
+#endif /* ADSRCURVED_H_ */
@@ -245,6 +245,93 @@ public:
 	}
 
 
+	/** Process a block of audio with the stored delay time, like calling next(input, delaytime_cells)
+	n times with the integer delay time.  The block is split where the read or write position wraps
+	around the buffer, so there is no masking of the positions for each sample.
+	@param in the signal input, n samples.
+	@param out receives the delayed signal, n samples.
+	@param n the number of samples.
+	*/
+	void process(const int8_t * in, int16_t * out, unsigned int n)
+	{
+		uint16_t w = (write_pos + 1) & (NUM_BUFFER_SAMPLES - 1);
+		uint16_t r = (w - _delaytime_cells) & (NUM_BUFFER_SAMPLES - 1);
+		while (n > 0){
+			// run until the first of the two positions wraps
+			unsigned int run = n;
+			if (run > (unsigned int)(NUM_BUFFER_SAMPLES - w)) run = NUM_BUFFER_SAMPLES - w;
+			if (run > (unsigned int)(NUM_BUFFER_SAMPLES - r)) run = NUM_BUFFER_SAMPLES - r;
+			int16_t * write_cell = delay_array + w;
+			const int16_t * read_cell = delay_array + r;
+			for (unsigned int i = 0; i < run; ++i){
+				const int16_t delay_sig = read_cell[i];
+				const int8_t feedback_sig = (int8_t) min(max(((delay_sig * _feedback_level)>>7),-128),127); // feedback clipped
+				write_cell[i] = (int16_t) in[i] + feedback_sig;
+				out[i] = delay_sig;
+			}
+			in += run;
+			out += run;
+			n -= run;
+			w = (w + run) & (NUM_BUFFER_SAMPLES - 1);
+			r = (r + run) & (NUM_BUFFER_SAMPLES - 1);
+		}
+		write_pos = (w - 1) & (NUM_BUFFER_SAMPLES - 1);
+	}
+
+
+	/** Process a block of audio with a modulated fractional delay time, like calling
+	next(input, delaytime_cells) n times with delaytime_cells moving in a straight line from
+	start_delaytime_cells to end_delaytime_cells.  Feeding the end time of one block to the start
+	of the next gives a smooth sweep for flanging from a control rate LFO.
+	@param in the signal input, n samples.
+	@param out receives the delayed signal, n samples.
+	@param n the number of samples.
+	@param start_delaytime_cells the delay time in cells for the first sample.
+	@param end_delaytime_cells the delay time in cells after the last sample.
+	*/
+	void process(const int8_t * in, int16_t * out, unsigned int n, Q16n16 start_delaytime_cells, Q16n16 end_delaytime_cells)
+	{
+		if (n == 0) return;
+		Q15n16 delaytime_cells = start_delaytime_cells;
+		const Q15n16 step = ((Q15n16)end_delaytime_cells - (Q15n16)start_delaytime_cells) / (int32_t)n;
+		uint16_t w = write_pos;
+		for (unsigned int i = 0; i < n; ++i){
+			++w &= (NUM_BUFFER_SAMPLES - 1);
+			const int16_t delay_sig = interpolate(w, delaytime_cells);
+			const int8_t feedback_sig = (int8_t) min(max(((delay_sig * _feedback_level)>>7),-128),127); // feedback clipped
+			delay_array[w] = (int16_t) in[i] + feedback_sig;
+			out[i] = delay_sig;
+			delaytime_cells += step;
+		}
+		write_pos = w;
+	}
+
+
+	/** Add another fractional read tap to the output of the block which was just processed,
+	without feedback.  Call it after process(), with the same out and n, once for each tap,
+	for chorus voices from one delay line.
+	The tap's delay time moves in a straight line from start_delaytime_cells to end_delaytime_cells
+	across the block.  It must stay below NUM_BUFFER_SAMPLES - n, so that the tap doesn't read cells
+	which the block has already overwritten.
+	@param out the output of process(), n samples.  The tap is added to it.
+	@param n the number of samples, the same as for process().
+	@param start_delaytime_cells the tap's delay time in cells for the first sample.
+	@param end_delaytime_cells the tap's delay time in cells after the last sample.
+	*/
+	void mixTap(int16_t * out, unsigned int n, Q16n16 start_delaytime_cells, Q16n16 end_delaytime_cells)
+	{
+		if (n == 0) return;
+		Q15n16 delaytime_cells = start_delaytime_cells;
+		const Q15n16 step = ((Q15n16)end_delaytime_cells - (Q15n16)start_delaytime_cells) / (int32_t)n;
+		uint16_t w = (write_pos - n) & (NUM_BUFFER_SAMPLES - 1); // where the block started
+		for (unsigned int i = 0; i < n; ++i){
+			++w &= (NUM_BUFFER_SAMPLES - 1);
+			out[i] += interpolate(w, delaytime_cells);
+			delaytime_cells += step;
+		}
+	}
+
+
 
 private:
 	int16_t delay_array[NUM_BUFFER_SAMPLES];
@@ -377,25 +464,27 @@ private:
 	*/
 	inline
 	int16_t read(Q16n16 delaytime_cells, Int2Type<LINEAR>)
+	{
+		return interpolate(write_pos, delaytime_cells);
+	}
+
+
+	/* The signal delaytime_cells before the cell at pos, interpolated between the two cells around it.
+	The second cell is the one before the first, so only the first position is masked from scratch. */
+	inline
+	int16_t interpolate(uint16_t pos, Q16n16 delaytime_cells)
 	{
 		uint16_t index = (Q16n16)delaytime_cells >> 16;
 		uint16_t fraction = (uint16_t) delaytime_cells; // keeps low word
 
-		uint16_t read_pos1 = (write_pos - index) & (NUM_BUFFER_SAMPLES - 1);
+		uint16_t read_pos1 = (pos - index) & (NUM_BUFFER_SAMPLES - 1);
 		int16_t delay_sig1 = delay_array[read_pos1];								// read the delay buffer
+		int16_t delay_sig2 = delay_array[(read_pos1 - 1) & (NUM_BUFFER_SAMPLES - 1)];
 
-		uint16_t read_pos2 = (write_pos - (index+1)) & (NUM_BUFFER_SAMPLES - 1);
-		int16_t delay_sig2 = delay_array[read_pos2];								// read the delay buffer
-
-		/*
 		int16_t difference = delay_sig2 - delay_sig1;
-		int16_t delay_sig_fraction = ((int32_t) fraction * difference) >> 16;
-
-		int16_t delay_sig = delay_sig1+delay_sig_fraction;
-		*/
-		int16_t delay_sig = delay_sig1 + ((int32_t)delay_sig2*fraction)>>16;
+		int16_t delay_sig_fraction = (int16_t)((int32_t)((int32_t) fraction * difference) >> 16);
 
-		return delay_sig;
+		return delay_sig1 + delay_sig_fraction;
 	}
 
 
@@ -0,0 +1,328 @@
+/*
+ * FMVoice.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef FMVOICE_H_
+#define FMVOICE_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "tables/sin2048_int8.h"
+
+/** Operator connections for FMVoice.  Operator 3 is the one with feedback,
+"3 > 2" means operator 3 modulates operator 2, and the carriers are summed to the output.
+*/
+enum FMAlgorithm {
+	FM_ALGORITHM_STACK,      /**< 3 > 2 > 1 > 0, one carrier */
+	FM_ALGORITHM_BRANCH,     /**< (3 + 2) > 1 > 0, one carrier */
+	FM_ALGORITHM_TWO_STACKS, /**< 3 > 2 and 1 > 0, carriers 2 and 0 */
+	FM_ALGORITHM_ONE_TO_THREE, /**< 3 > 2, 3 > 1 and 3 > 0, carriers 2, 1 and 0 */
+	FM_ALGORITHM_STACK_PLUS_ONE, /**< 3 > 2 > 1, and 0 on its own, carriers 1 and 0 */
+	FM_ALGORITHM_ADDITIVE    /**< no modulation, all four are carriers */
+};
+
+
+/** A four operator FM (phase modulation) voice.
+
+Each operator is a sine from SIN2048_DATA with its own frequency ratio, output level and envelope.
+The algorithm is a template parameter, so next() compiles to a straight line of four table lookups
+with no branches on the algorithm.  The operator phases, increments and amplitudes are kept in
+arrays side by side.
+
+The envelopes are rate based, like on the DX synths: the attack rises at a fixed rate, and the
+decay and release fall by a fraction of the level on each update(), so they are exponential.
+update() works out the level each operator will have at the next update(), and next() ramps to
+it, so there is no zipper noise at CONTROL_RATE.
+
+@tparam ALGORITHM one of the FMAlgorithm values.
+@tparam CONTROL_UPDATE_RATE the rate update() is called at, usually CONTROL_RATE.
+*/
+template <uint8_t ALGORITHM, unsigned int CONTROL_UPDATE_RATE>
+class FMVoice
+{
+
+public:
+	static const uint8_t NUM_OPERATORS = 4;
+
+	/** Constructor.
+	*/
+	FMVoice(): feedback(0)
+	{
+		for (uint8_t i = 0; i < NUM_OPERATORS; ++i){
+			phase[i] = 0;
+			phase_inc[i] = 0;
+			amp[i] = 0;
+			amp_step[i] = 0;
+			ratio[i] = 256;
+			level[i] = 255;
+			env_level[i] = 0;
+			env_phase[i] = IDLE;
+			setRates(i, 255, 128, 255, 128);
+		}
+		last_out[0] = last_out[1] = 0;
+		base_inc = 0;
+	}
+
+
+	/** Set the frequency of the voice.  Each operator plays it times its ratio.
+	@param freq the frequency in Hz.
+	*/
+	inline
+	void setFreq(float freq)
+	{
+		setFreq_Q16n16(float_to_Q16n16(freq));
+	}
+
+
+	/** Set the frequency of the voice, in fixed point.
+	@param freq the frequency in Hz, in Q16n16.
+	*/
+	inline
+	void setFreq_Q16n16(Q16n16 freq)
+	{
+		// AUDIO_RATE is a power of two, so freq * 2^32 / AUDIO_RATE is a shift
+		base_inc = freq << (16 - AUDIO_RATE_AS_LSHIFT);
+		for (uint8_t i = 0; i < NUM_OPERATORS; ++i) updateIncrement(i);
+	}
+
+
+	/** Set the frequency ratio of an operator to the voice frequency.
+	@param op the operator, 0 to 3.
+	@param op_ratio in Q8n8, so 256 is 1:1, 512 is 2:1 and 128 is 1:2.
+	*/
+	inline
+	void setRatio(uint8_t op, Q8n8 op_ratio)
+	{
+		ratio[op] = op_ratio;
+		updateIncrement(op);
+	}
+
+
+	/** Set the output level of an operator.  For a modulator this is its modulation index:
+	255 is a phase swing of about 2 pi.
+	@param op the operator, 0 to 3.
+	@param op_level 0 to 255.
+	*/
+	inline
+	void setLevel(uint8_t op, uint8_t op_level)
+	{
+		level[op] = op_level;
+	}
+
+
+	/** Set the self modulation of operator 3.
+	@param feedback_level 0 (none) to 255 (about pi).
+	*/
+	inline
+	void setFeedback(uint8_t feedback_level)
+	{
+		feedback = feedback_level;
+	}
+
+
+	/** Set the envelope rates of an operator.
+	@param op the operator, 0 to 3.
+	@param attack_rate 0 (about 4 seconds) to 255 (one update).
+	@param decay_rate 0 (slow) to 255 (fast), towards the sustain level.
+	@param sustain_level 0 to 255.
+	@param release_rate 0 (slow) to 255 (fast).
+	*/
+	inline
+	void setRates(uint8_t op, uint8_t attack_rate, uint8_t decay_rate, uint8_t sustain_level, uint8_t release_rate)
+	{
+		// attack in Q0n24 per update, doubling every 32 steps of the rate:
+		// 256 updates at rate 0, 1 update at rate 255
+		attack_step[op] = (int32_t)(256 + ((attack_rate & 31) << 3)) << (8 + (attack_rate >> 5));
+		decay_coeff[op] = decay_rate + 1;
+		sustain[op] = (int32_t)sustain_level << 16;
+		release_coeff[op] = release_rate + 1;
+	}
+
+
+	/** Start the envelopes of all the operators from their current level.
+	*/
+	inline
+	void noteOn()
+	{
+		for (uint8_t i = 0; i < NUM_OPERATORS; ++i) env_phase[i] = ATTACK;
+	}
+
+
+	/** Start the release of all the operators.
+	*/
+	inline
+	void noteOff()
+	{
+		for (uint8_t i = 0; i < NUM_OPERATORS; ++i){
+			if (env_phase[i] != IDLE) env_phase[i] = RELEASE;
+		}
+	}
+
+
+	/** Tells if any operator envelope is still running.
+	*/
+	inline
+	bool playing()
+	{
+		return (env_phase[0] | env_phase[1] | env_phase[2] | env_phase[3]) != IDLE;
+	}
+
+
+	/** Advance the envelopes.  Call this in updateControl().
+	*/
+	void update()
+	{
+		for (uint8_t i = 0; i < NUM_OPERATORS; ++i){
+			int32_t e = env_level[i];
+			switch (env_phase[i]){
+			case ATTACK:
+				e += attack_step[i];
+				if (e >= FULL_SCALE){
+					e = FULL_SCALE;
+					env_phase[i] = DECAY;
+				}
+				break;
+			case DECAY:
+				e += (int32_t)(((int64_t)(sustain[i] - e) * decay_coeff[i]) >> 9);
+				break;
+			case RELEASE:
+				e -= (int32_t)(((int64_t)e * release_coeff[i]) >> 9);
+				if (e < SILENT){
+					e = 0;
+					env_phase[i] = IDLE;
+				}
+				break;
+			default:
+				break;
+			}
+			env_level[i] = e;
+
+			// ramp to the new amplitude over the next update period
+			const int32_t target = (int32_t)(((int64_t)e * level[i]) >> 8);
+			amp_step[i] = (target - amp[i]) / (int32_t)(AUDIO_RATE / CONTROL_UPDATE_RATE);
+		}
+	}
+
+
+	/** Calculate the next sample.
+	@return the sum of the carriers, 15 bits for each carrier.
+	*/
+	inline
+	int next()
+	{
+		for (uint8_t i = 0; i < NUM_OPERATORS; ++i){
+			phase[i] += phase_inc[i];
+			amp[i] += amp_step[i];
+		}
+
+		// feedback is the average of the last two outputs of operator 3, which keeps it stable
+		const uint32_t fb_mod = (uint32_t)((last_out[0] + last_out[1]) * (int32_t)feedback) << 7;
+		const int32_t o3 = op(3, fb_mod);
+		last_out[1] = last_out[0];
+		last_out[0] = o3;
+
+		// ALGORITHM is a constant, so only one of these is compiled in
+		switch (ALGORITHM){
+		case FM_ALGORITHM_STACK: {
+			const int32_t o2 = op(2, mod(o3));
+			const int32_t o1 = op(1, mod(o2));
+			return op(0, mod(o1));
+		}
+		case FM_ALGORITHM_BRANCH: {
+			const int32_t o2 = op(2, 0);
+			const int32_t o1 = op(1, mod(o3 + o2));
+			return op(0, mod(o1));
+		}
+		case FM_ALGORITHM_TWO_STACKS: {
+			const int32_t o2 = op(2, mod(o3));
+			const int32_t o1 = op(1, 0);
+			return o2 + op(0, mod(o1));
+		}
+		case FM_ALGORITHM_ONE_TO_THREE: {
+			const uint32_t m = mod(o3);
+			return op(2, m) + op(1, m) + op(0, m);
+		}
+		case FM_ALGORITHM_STACK_PLUS_ONE: {
+			const int32_t o2 = op(2, mod(o3));
+			return op(1, mod(o2)) + op(0, 0);
+		}
+		default: // FM_ALGORITHM_ADDITIVE
+			return o3 + op(2, 0) + op(1, 0) + op(0, 0);
+		}
+	}
+
+
+	/** Calculate a block of samples.
+	@param out receives the output, n samples, clipped to 16 bits.
+	@param n the number of samples.
+	*/
+	void process(int16_t * out, unsigned int n)
+	{
+		for (unsigned int i = 0; i < n; ++i){
+			out[i] = (int16_t) constrain(next(), -32768, 32767);
+		}
+	}
+
+
+private:
+	enum { IDLE, ATTACK, DECAY, RELEASE };
+	static const int32_t FULL_SCALE = (int32_t)1 << 24; // envelope levels are Q0n24
+	static const int32_t SILENT = (int32_t)1 << 12;
+
+	// per sample state, side by side
+	uint32_t phase[NUM_OPERATORS];
+	uint32_t phase_inc[NUM_OPERATORS];
+	int32_t amp[NUM_OPERATORS];       // Q0n24, envelope times level
+	int32_t amp_step[NUM_OPERATORS];
+
+	// per update state
+	uint32_t base_inc;
+	Q8n8 ratio[NUM_OPERATORS];
+	uint8_t level[NUM_OPERATORS];
+	int32_t env_level[NUM_OPERATORS]; // Q0n24
+	uint8_t env_phase[NUM_OPERATORS];
+	int32_t attack_step[NUM_OPERATORS];
+	int16_t decay_coeff[NUM_OPERATORS];
+	int32_t sustain[NUM_OPERATORS];
+	int16_t release_coeff[NUM_OPERATORS];
+
+	uint8_t feedback;
+	int32_t last_out[2];
+
+
+	inline
+	void updateIncrement(uint8_t op)
+	{
+		phase_inc[op] = (uint32_t)(((uint64_t)base_inc * ratio[op]) >> 8);
+	}
+
+
+	/* an operator output in Q0n15, with the phase offset by modulation */
+	inline
+	int32_t op(uint8_t i, uint32_t modulation)
+	{
+		const int8_t s = FLASH_OR_RAM_READ<const int8_t>(SIN2048_DATA + ((phase[i] + modulation) >> 21));
+		return ((int32_t)s * (amp[i] >> 8)) >> 8;
+	}
+
+
+	/* an operator output as a phase offset, full scale is one cycle */
+	static inline
+	uint32_t mod(int32_t op_out)
+	{
+		return (uint32_t)op_out << 17;
+	}
+};
+
+#endif        //  #ifndef FMVOICE_H_
@@ -0,0 +1,287 @@
+/*
+ * Fixed.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef FIXED_H_
+#define FIXED_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "IntegerType.h"
+#include "mozzi_fixmath.h"
+
+#if defined(__XTENSA__)
+ #include <xtensa/config/core-isa.h>
+#endif
+
+/** @ingroup fixmath
+Clamp a number to a signed range of BITS bits, -(2^(BITS-1)) to 2^(BITS-1) - 1.  On the ESP32
+this is one CLAMPS instruction for 8 to 23 bits, elsewhere it is two compares.
+@tparam BITS the number of bits to keep, including the sign.
+@param x the number to clamp.
+@return x, clamped.
+*/
+template <uint8_t BITS>
+inline
+int32_t clampSigned(int32_t x)
+{
+	static_assert(BITS >= 2 && BITS <= 32, "clampSigned keeps 2 to 32 bits");
+#if defined(__XTENSA__) && XCHAL_HAVE_CLAMPS
+	if (BITS >= 8 && BITS <= 23) {
+		int32_t y;
+		asm ("clamps %0, %1, %2" : "=r" (y) : "r" (x), "i" ((BITS >= 8 && BITS <= 23) ? BITS - 1 : 7));
+		return y;
+	}
+#endif
+	const int32_t hi = (int32_t)(((uint32_t)1 << (BITS - 1)) - 1);
+	const int32_t lo = -hi - 1;
+	return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+
+template <bool CONDITION, class A, class B> struct FixedSelect { typedef A type; };
+template <class A, class B> struct FixedSelect<false, A, B> { typedef B type; };
+
+/* the wider of two integer types, signed or not */
+template <class A, class B, bool SIGNED> struct FixedWider
+{
+	typedef IntegerType<(sizeof(A) > sizeof(B)) ? sizeof(A) : sizeof(B)> Int;
+	typedef typename FixedSelect<SIGNED, typename Int::signed_type, typename Int::unsigned_type>::type type;
+};
+
+
+/** @ingroup fixmath
+A fixed point number in a template, which knows its own format.
+
+Fixed<INT_BITS, FRAC_BITS, SIGNED> holds the same number as the typedefs in mozzi_fixmath.h with
+the same name: Fixed<15, 16> is a Q15n16, Fixed<16, 16, false> a Q16n16, Fixed<0, 7> a Q0n7.
+The sign bit is not counted in INT_BITS, as in the typedef names.  The number is kept in the
+smallest integer which holds it, so a Fixed is the same size as its typedef and costs nothing
+extra, and asRaw() and fromRaw() move between the two, to use a Fixed with functions which take
+the typedefs.
+
+Multiplying two Fixed numbers gives a Fixed with enough bits for any result, worked out at
+compile time, so there is no silent overflow: Fixed<7, 8> * Fixed<0, 15> is a Fixed<8, 23>,
+kept in 32 bits.  It doesn't compile if the result would need more than 64 bits.  The result
+can then be narrowed to the format wanted with the converting constructor, which truncates, or
+with saturate(), which clamps the integer part.
+
+Adding and subtracting keep the format and wrap round like the typedefs, sadd() and ssub() clamp
+instead.  The conversions from float are constexpr, so constants are worked out by the compiler.
+@code
+const Fixed<0, 15> gain(0.7f);          // 22938, at compile time
+Fixed<7, 8> x = Fixed<7, 8>::fromRaw(sample << 8);
+int16_t out = saturate<7, 8>(x * gain).asRaw(); // clamped, no overflow
+@endcode
+@tparam INT_BITS the number of integer bits, not counting the sign.
+@tparam FRAC_BITS the number of fractional bits.
+@tparam SIGNED true for a signed number (the default), false for unsigned.
+*/
+template <uint8_t INT_BITS, uint8_t FRAC_BITS, bool SIGNED = true>
+class Fixed
+{
+	static_assert(INT_BITS + FRAC_BITS + (SIGNED ? 1 : 0) <= 64, "Fixed needs more than 64 bits");
+
+public:
+	/** The number of bits used, including the sign. */
+	static const uint8_t BITS = INT_BITS + FRAC_BITS + (SIGNED ? 1 : 0);
+
+	/** The integer type the number is kept in. */
+	typedef typename IntegerType<(BITS + 7) / 8>::unsigned_type unsigned_type;
+	typedef typename IntegerType<(BITS + 7) / 8>::signed_type signed_type;
+	typedef typename FixedSelect<SIGNED, signed_type, unsigned_type>::type internal_type;
+
+
+	/** Constructor, 0.
+	*/
+	constexpr Fixed(): value(0)
+	{}
+
+
+	/** Constructor from a float or double, rounded to the nearest.  This is constexpr, so a constant
+	made from a literal costs nothing at run time.
+	@param x the number.
+	*/
+	constexpr explicit Fixed(double x): value(fromFloat(x))
+	{}
+
+
+	/** Constructor from an integer.
+	@param x the number, which must fit in INT_BITS.
+	*/
+	constexpr explicit Fixed(int x): value((internal_type)((unsigned_type)x * ((unsigned_type)1 << FRAC_BITS)))
+	{}
+
+
+	/** Constructor from a Fixed in another format.  Fractional bits are added as 0 or truncated,
+	and integer bits which don't fit are lost, use saturate() to clamp them.
+	@param x the number.
+	*/
+	template <uint8_t I, uint8_t F, bool S>
+	constexpr explicit Fixed(const Fixed<I, F, S> & x):
+		value((internal_type)shift<F, FRAC_BITS>((typename FixedWider<internal_type, typename Fixed<I, F, S>::internal_type, S>::type)x.asRaw()))
+	{}
+
+
+	/** Make a Fixed from the raw bits, for example a Q15n16 made by the functions in mozzi_fixmath.h.
+	@param raw the number times 2^FRAC_BITS.
+	*/
+	static constexpr Fixed fromRaw(internal_type raw)
+	{
+		return Fixed(raw, RawTag());
+	}
+
+
+	/** The raw bits, which are the same as the matching typedef from mozzi_fixmath.h.
+	@return the number times 2^FRAC_BITS.
+	*/
+	constexpr internal_type asRaw() const
+	{
+		return value;
+	}
+
+
+	/** The integer part, rounded down.
+	*/
+	constexpr internal_type asInt() const
+	{
+		return value >> FRAC_BITS;
+	}
+
+
+	/** The number as a float.
+	*/
+	constexpr float asFloat() const
+	{
+		return (float)value / ((uint64_t)1 << FRAC_BITS);
+	}
+
+
+	/** Add, in the same format, wrapping round if it overflows.
+	*/
+	constexpr Fixed operator+(const Fixed & b) const
+	{
+		return fromRaw((internal_type)(value + b.value));
+	}
+
+
+	/** Subtract, in the same format, wrapping round if it overflows.
+	*/
+	constexpr Fixed operator-(const Fixed & b) const
+	{
+		return fromRaw((internal_type)(value - b.value));
+	}
+
+
+	/** Negate.  This gives a signed Fixed with one more integer bit if the Fixed is unsigned.
+	*/
+	constexpr Fixed<SIGNED ? INT_BITS : INT_BITS + 1, FRAC_BITS, true> operator-() const
+	{
+		return Fixed<SIGNED ? INT_BITS : INT_BITS + 1, FRAC_BITS, true>::fromRaw(-(typename Fixed<SIGNED ? INT_BITS : INT_BITS + 1, FRAC_BITS, true>::internal_type)value);
+	}
+
+
+	/** Multiply, giving a Fixed with the integer and fractional bits of both, which can hold any
+	result.  The multiply is done in the size of the result, so two 16 bit numbers take one 16 x 16
+	to 32 bit multiply.
+	*/
+	template <uint8_t I, uint8_t F, bool S>
+	constexpr Fixed<INT_BITS + I + ((SIGNED && S) ? 1 : 0), FRAC_BITS + F, SIGNED || S> operator*(const Fixed<I, F, S> & b) const
+	{
+		typedef Fixed<INT_BITS + I + ((SIGNED && S) ? 1 : 0), FRAC_BITS + F, SIGNED || S> Product;
+		return Product::fromRaw((typename Product::internal_type)value * (typename Product::internal_type)b.asRaw());
+	}
+
+
+	bool operator==(const Fixed & b) const { return value == b.value; }
+	bool operator!=(const Fixed & b) const { return value != b.value; }
+	bool operator<(const Fixed & b) const { return value < b.value; }
+	bool operator>(const Fixed & b) const { return value > b.value; }
+	bool operator<=(const Fixed & b) const { return value <= b.value; }
+	bool operator>=(const Fixed & b) const { return value >= b.value; }
+
+
+private:
+	struct RawTag {};
+
+	internal_type value;
+
+	constexpr Fixed(internal_type raw, RawTag): value(raw)
+	{}
+
+	static constexpr internal_type fromFloat(double x)
+	{
+		return (internal_type)((x >= 0) ? (int64_t)(x * ((uint64_t)1 << FRAC_BITS) + 0.5) : -(int64_t)(0.5 - x * ((uint64_t)1 << FRAC_BITS)));
+	}
+
+	/* move a raw value from one number of fractional bits to another, multiplying rather than
+	shifting left, as shifting a negative number left isn't allowed in a constexpr */
+	template <uint8_t FROM, uint8_t TO, class T>
+	static constexpr T shift(T x)
+	{
+		typedef typename IntegerType<sizeof(T)>::unsigned_type U;
+		return (TO >= FROM) ? (T)((U)x * ((U)1 << ((TO >= FROM) ? TO - FROM : 0))) : (T)(x >> ((FROM > TO) ? FROM - TO : 0));
+	}
+
+	template <uint8_t I, uint8_t F, bool S> friend class Fixed;
+};
+
+
+/** @ingroup fixmath
+Narrow a Fixed to another format, clamping it to the largest or smallest number the new format
+holds instead of wrapping round.  Fractional bits are truncated.
+@tparam INT_BITS, FRAC_BITS, SIGNED the format to convert to.
+@param x the number to convert.
+@return x, clamped.
+*/
+template <uint8_t INT_BITS, uint8_t FRAC_BITS, bool SIGNED = true, uint8_t I, uint8_t F, bool S>
+inline
+Fixed<INT_BITS, FRAC_BITS, SIGNED> saturate(const Fixed<I, F, S> & x)
+{
+	typedef Fixed<INT_BITS, FRAC_BITS, SIGNED> To;
+	static_assert(To::BITS <= 32, "saturate() converts to 32 bits or less");
+	// the raw value with the new number of fractional bits, signed and wide enough not to overflow,
+	// and for the limits of an unsigned format of 31 or 32 bits
+	typedef typename FixedSelect<(I + 2 + ((F > FRAC_BITS) ? F : FRAC_BITS) <= 32) && (SIGNED || To::BITS < 31), int32_t, int64_t>::type wide_type;
+	const wide_type raw = (F >= FRAC_BITS) ? ((wide_type)x.asRaw() >> ((F >= FRAC_BITS) ? F - FRAC_BITS : 0))
+		: ((wide_type)x.asRaw() * ((wide_type)1 << ((FRAC_BITS > F) ? FRAC_BITS - F : 0)));
+	if (SIGNED && sizeof(wide_type) == 4) {
+		return To::fromRaw((typename To::internal_type)clampSigned<(To::BITS >= 2) ? To::BITS : 2>((int32_t)raw));
+	}
+	const wide_type hi = (wide_type)(((uint64_t)1 << (To::BITS - (SIGNED ? 1 : 0))) - 1);
+	const wide_type lo = SIGNED ? -hi - 1 : 0;
+	return To::fromRaw((typename To::internal_type)((raw < lo) ? lo : (raw > hi) ? hi : raw));
+}
+
+
+/** @ingroup fixmath
+Add, clamping the result instead of wrapping round.
+*/
+template <uint8_t I, uint8_t F, bool S>
+inline
+Fixed<I, F, S> sadd(const Fixed<I, F, S> & a, const Fixed<I, F, S> & b)
+{
+	return saturate<I, F, S>(Fixed<I + 1, F, true>::fromRaw((typename Fixed<I + 1, F, true>::internal_type)a.asRaw() + b.asRaw()));
+}
+
+
+/** @ingroup fixmath
+Subtract, clamping the result instead of wrapping round.
+*/
+template <uint8_t I, uint8_t F, bool S>
+inline
+Fixed<I, F, S> ssub(const Fixed<I, F, S> & a, const Fixed<I, F, S> & b)
+{
+	return saturate<I, F, S>(Fixed<I + 1, F, true>::fromRaw((typename Fixed<I + 1, F, true>::internal_type)a.asRaw() - b.asRaw()));
+}
+
+#endif        //  #ifndef FIXED_H_
@@ -0,0 +1,141 @@
+/*
+ * Glide.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef GLIDE_H_
+#define GLIDE_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "MozziGuts.h"
+#include "mozzi_fixmath.h"
+
+/** A glide (portamento) at audio rate, which slides an oscillator's phase increment from one
+frequency to the next.
+
+Portamento slides a Line in midi notes at control rate, and turns each step into a frequency with
+Q16n16_mtof(), so the slide is a staircase of CONTROL_RATE steps.  Glide works on the phase
+increment itself: at start() it works out, once, the ratio between the increments of one sample
+and the next, 2^(octaves / samples), and next() multiplies the increment by it, which is one
+multiply a sample, evenly spaced in pitch, with no steps.  The last sample is set to the target
+exactly, so rounding in the ratio never leaves the note out of tune.
+
+Use it with Oscil::phaseIncFromFreq() and Oscil::setPhaseInc():
+@code
+aGlide.start(aOscil.phaseIncFromFreq(440)); // at a new note
+...
+aOscil.setPhaseInc(aGlide.next());          // in updateAudio()
+@endcode
+@tparam UPDATE_RATE the rate next() is called at, AUDIO_RATE by default.
+*/
+template <unsigned int UPDATE_RATE = AUDIO_RATE>
+class Glide
+{
+
+public:
+	/** Constructor.
+	*/
+	Glide(): increment(0), target(0), ratio((uint32_t)1 << 30), remaining(0), glide_samples(0)
+	{}
+
+
+	/** Set how long it takes to slide from one note to the next.
+	@param milliseconds 0 to jump straight to each note.
+	*/
+	inline
+	void setTime(unsigned int milliseconds)
+	{
+		glide_samples = ((uint32_t)milliseconds * UPDATE_RATE) / 1000;
+	}
+
+
+	/** Jump straight to a phase increment, without a slide.
+	@param phase_inc from Oscil::phaseIncFromFreq(), or any other phase increment.
+	*/
+	inline
+	void set(unsigned long phase_inc)
+	{
+		increment = target = phase_inc;
+		remaining = 0;
+	}
+
+
+	/** Slide from where the glide is now to a new phase increment, over the time from setTime().  The
+	first note, or a note from a phase increment of 0, is jumped to.
+	@param phase_inc from Oscil::phaseIncFromFreq(), or any other phase increment.
+	*/
+	void start(unsigned long phase_inc)
+	{
+		if (glide_samples == 0 || increment == 0 || phase_inc == 0) {
+			set(phase_inc);
+			return;
+		}
+		target = phase_inc;
+		remaining = glide_samples;
+		// octaves between the two, from log2 of each, over the number of samples, in Q0n30
+		const int32_t octaves = log2(phase_inc) - log2(increment); // Q15n16
+		const int32_t step = (int32_t)(((int64_t)octaves * 16384) / (int32_t)glide_samples);
+		ratio = exp2Small(step);
+	}
+
+
+	/** Tells if it is still sliding.
+	*/
+	inline
+	bool isGliding()
+	{
+		return remaining != 0;
+	}
+
+
+	/** Step the glide on one sample.
+	@return the phase increment for this sample.
+	*/
+	inline
+	unsigned long next()
+	{
+		if (remaining) {
+			increment = (--remaining == 0) ? target
+				: (unsigned long)(((uint64_t)increment * ratio + ((uint32_t)1 << 29)) >> 30);
+		}
+		return increment;
+	}
+
+
+private:
+	unsigned long increment, target;
+	uint32_t ratio; // from one sample to the next, Q2n30
+	uint32_t remaining, glide_samples;
+
+
+	/* log2 of a phase increment, in Q15n16 octaves, which only needs to be right relative to another */
+	static inline
+	int32_t log2(unsigned long phase_inc)
+	{
+		return Q16n16_log2((Q16n16)phase_inc);
+	}
+
+
+	/* 2^x for x in Q0n30, up to 1 octave either way, from the series, in Q2n30 */
+	static
+	uint32_t exp2Small(int32_t x)
+	{
+		if (x > ((int32_t)1 << 30)) x = (int32_t)1 << 30;
+		if (x < -((int32_t)1 << 30)) x = -((int32_t)1 << 30);
+		const int32_t t = mult_s32x32_shr<31>(x, 1488522236); // x ln2, with ln2 in Q0n31
+		const int32_t t2 = mult_s32x32_shr<30>(t, t);
+		const int32_t t3 = mult_s32x32_shr<30>(t2, t);
+		return (uint32_t)(((int32_t)1 << 30) + t + (t2 >> 1) + t3 / 6);
+	}
+};
+
+#endif        //  #ifndef GLIDE_H_
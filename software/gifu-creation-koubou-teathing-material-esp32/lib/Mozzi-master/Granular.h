@@ -0,0 +1,271 @@
+/*
+ * Granular.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef GRANULAR_H_
+#define GRANULAR_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "mozzi_rand.h"
+#include "tables/halfsinwindow512_uint8.h"
+
+/** A granular player for a sound table.
+
+Grains are short pieces of the table, each faded in and out with the first half of
+HALFSINWINDOW512_DATA, started at a steady rate set by setDensity() and summed.  Each grain
+starts near setPosition(), moved by up to setPositionSpread() cells at random, and plays at
+setSpeed() plus up to setSpeedSpread() at random, with the randomness from xorshift96().
+Changes apply to the grains started after them, so they can come straight from knobs or touch in
+updateControl().
+
+The grains live in a fixed pool of MAX_GRAINS, with a free list and a list of the playing ones, so
+there is no heap and the mix only visits the grains that are playing.  When the pool is full, new
+grains are skipped until one finishes.
+
+Grains are started at sample times counted from the first call, not at control updates, so the
+timing doesn't jitter with CONTROL_RATE.  process() renders one grain at a time across the block,
+starting each new grain at its own sample in the block.
+
+@tparam NUM_TABLE_CELLS the length of the sound table, which can be any length, as for Sample.
+@tparam MAX_GRAINS the most grains that can play at once, up to 254.
+*/
+template <unsigned int NUM_TABLE_CELLS, uint8_t MAX_GRAINS = 8>
+class Granular
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of the array with the sound, for example made with char2mozzi.py.
+	*/
+	Granular(const int8_t * TABLE_NAME): table(TABLE_NAME), now(0), next_grain_time(0), grain_interval(0),
+		position(0), position_spread(0), speed(256), speed_spread(0)
+	{
+		setGrainLength(AUDIO_RATE / 20);
+		clear();
+	}
+
+
+	/** Stop all the grains.
+	*/
+	void clear()
+	{
+		active_head = NONE;
+		free_head = 0;
+		for (uint8_t i = 0; i < MAX_GRAINS; ++i) grains[i].next = i + 1;
+		grains[MAX_GRAINS - 1].next = NONE;
+	}
+
+
+	/** Set how many grains start each second.
+	@param grains_per_second 0 stops new grains.  With overlapping grains it is best kept below
+	MAX_GRAINS * AUDIO_RATE / grain length.
+	*/
+	inline
+	void setDensity(unsigned int grains_per_second)
+	{
+		const uint32_t interval = grains_per_second ? (uint32_t)AUDIO_RATE / grains_per_second : 0;
+		// start the first grain straight away when density goes up from 0
+		if (grain_interval == 0 && interval) next_grain_time = now;
+		grain_interval = interval;
+	}
+
+
+	/** Set the length of the grains started from now on.
+	@param num_samples from 2 to 65535 samples of output.
+	*/
+	inline
+	void setGrainLength(unsigned int num_samples)
+	{
+		if (num_samples < 2) num_samples = 2;
+		if (num_samples > 65535) num_samples = 65535;
+		grain_length = num_samples;
+		window_increment = ((uint32_t)WINDOW_CELLS << 16) / num_samples;
+	}
+
+
+	/** Set where in the table the grains start.
+	@param start_cell from 0 to NUM_TABLE_CELLS - 1.
+	*/
+	inline
+	void setPosition(unsigned int start_cell)
+	{
+		position = start_cell;
+	}
+
+
+	/** Set how far the grains can start from the position, either side, at random.
+	@param num_cells 0 for every grain to start at the position.
+	*/
+	inline
+	void setPositionSpread(unsigned int num_cells)
+	{
+		position_spread = num_cells;
+	}
+
+
+	/** Set the playback speed of the grains.
+	@param playback_speed in Q8n8, so 256 plays at the recorded pitch, 512 an octave up.
+	*/
+	inline
+	void setSpeed(Q8n8 playback_speed)
+	{
+		speed = playback_speed;
+	}
+
+
+	/** Set how much the speed of each grain can vary, up or down, at random.
+	@param spread in Q8n8, the largest change either way.  It won't take the speed below 0.
+	*/
+	inline
+	void setSpeedSpread(Q8n8 spread)
+	{
+		speed_spread = spread;
+	}
+
+
+	/** Calculate the next sample.
+	@return the sum of the grains, each up to 8 bits.
+	*/
+	inline
+	int next()
+	{
+		int16_t out;
+		process(&out, 1);
+		return out;
+	}
+
+
+	/** Fill a block with the sum of the grains.
+	@param out receives n samples.
+	@param n the number of samples.
+	*/
+	void process(int16_t * out, unsigned int n)
+	{
+		for (unsigned int j = 0; j < n; ++j) out[j] = 0;
+
+		// start the grains due in this block, at their own sample
+		if (grain_interval) {
+			while ((int32_t)(next_grain_time - now) < (int32_t)n) {
+				startGrain((uint16_t)(next_grain_time - now));
+				next_grain_time += grain_interval;
+			}
+		}
+
+		uint8_t * link = &active_head;
+		while (*link != NONE) {
+			Grain & g = grains[*link];
+			if (renderGrain(g, out, n)) {
+				link = &g.next;
+			} else {
+				// finished, move it to the free list
+				const uint8_t finished = *link;
+				*link = g.next;
+				g.next = free_head;
+				free_head = finished;
+			}
+		}
+		now += n;
+	}
+
+
+private:
+	static const uint8_t NONE = 255;
+	static const unsigned int WINDOW_CELLS = HALFSINWINDOW512_NUM_CELLS / 2; // the rising and falling half
+
+	struct Grain {
+		unsigned long phase;     // position in the table, Q16n16
+		unsigned long increment; // Q16n16 cells per sample
+		uint32_t window_phase;   // Q8n16 cells of the window
+		uint32_t window_increment;
+		uint16_t remaining;      // samples left to play
+		uint16_t delay;          // samples into the next block before it starts
+		uint8_t next;            // next grain in the free or playing list
+	};
+
+	Grain grains[MAX_GRAINS];
+	uint8_t free_head, active_head;
+	const int8_t * table;
+	uint32_t now, next_grain_time, grain_interval; // in samples
+	uint16_t grain_length;
+	uint32_t window_increment; // Q8n16
+	unsigned int position, position_spread;
+	Q8n8 speed, speed_spread;
+
+
+	/* a random number from -spread to spread */
+	static inline
+	int32_t randomSpread(unsigned int spread)
+	{
+		if (spread == 0) return 0;
+		return (int32_t)(((uint64_t)(xorshift96() & 0xffff) * (2 * (uint32_t)spread + 1)) >> 16) - (int32_t)spread;
+	}
+
+
+	void startGrain(uint16_t delay)
+	{
+		if (free_head == NONE) return; // all playing
+		const uint8_t i = free_head;
+		Grain & g = grains[i];
+		free_head = g.next;
+
+		int32_t start = (int32_t)position + randomSpread(position_spread);
+		start %= (int32_t)NUM_TABLE_CELLS;
+		if (start < 0) start += NUM_TABLE_CELLS;
+		int32_t grain_speed = (int32_t)speed + randomSpread(speed_spread);
+		if (grain_speed < 0) grain_speed = 0;
+
+		g.phase = (unsigned long)start << 16;
+		g.increment = (unsigned long)grain_speed << 8;
+		g.window_phase = 0;
+		g.window_increment = window_increment;
+		g.remaining = grain_length;
+		g.delay = delay;
+		g.next = active_head;
+		active_head = i;
+	}
+
+
+	/* add a grain into out, returns false when it has finished */
+	inline
+	bool renderGrain(Grain & g, int16_t * out, unsigned int n)
+	{
+		if (g.delay >= n) {
+			g.delay -= n;
+			return true;
+		}
+		unsigned int j = g.delay;
+		g.delay = 0;
+		unsigned int end = j + g.remaining;
+		if (end > n) end = n;
+		g.remaining -= end - j;
+
+		const unsigned long table_end = (unsigned long)NUM_TABLE_CELLS << 16;
+		unsigned long phase = g.phase;
+		uint32_t window_phase = g.window_phase;
+		for (; j < end; ++j) {
+			const int16_t s = FLASH_OR_RAM_READ<const int8_t>(table + (phase >> 16));
+			const uint16_t w = FLASH_OR_RAM_READ<const uint8_t>(HALFSINWINDOW512_DATA + (window_phase >> 16));
+			out[j] += (s * w) >> 8;
+			phase += g.increment;
+			if (phase >= table_end) phase -= table_end; // grains wrap round the table
+			window_phase += g.window_increment;
+		}
+		g.phase = phase;
+		g.window_phase = window_phase;
+		return g.remaining != 0;
+	}
+};
+
+#endif        //  #ifndef GRANULAR_H_
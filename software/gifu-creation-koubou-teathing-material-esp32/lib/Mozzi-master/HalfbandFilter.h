@@ -0,0 +1,120 @@
+/*
+ * HalfbandFilter.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef HALFBANDFILTER_H_
+#define HALFBANDFILTER_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+/** Coefficients for HalfbandFilter<6, ...>: passband to 0.18 of the higher rate (0.02dB ripple),
+stopband from 0.32 (-51dB).  For a first 2x stage this passes 11.8kHz at an AUDIO_RATE of 32768.
+*/
+static const int16_t HALFBAND_6_PAIRS[6] = {-64, 236, -607, 1346, -2981, 10262};
+
+/** Coefficients for HalfbandFilter<3, ...>: passband to 0.1 of the higher rate (0.01dB ripple),
+stopband from 0.4 (-59dB).  Good for a second 2x stage after HALFBAND_6_PAIRS.
+*/
+static const int16_t HALFBAND_3_PAIRS[3] = {302, -1873, 9763};
+
+
+/** A polyphase halfband FIR filter, for upsampling or downsampling by 2.
+
+A halfband filter has every other tap zero apart from the centre one, which is 1/2, and is
+symmetric, so a filter with 4 * NUM_PAIRS - 1 taps only needs NUM_PAIRS multiplies for each
+sample at the lower rate: upsample() works out every second output with NUM_PAIRS multiplies and
+the ones in between are the input, delayed; downsample() only works out the outputs it keeps.
+
+The filter works a block at a time: the new samples are copied in after the last few samples of
+the previous block, the block is filtered from one straight array, and the last few samples are
+moved back to the start.  The same object can upsample and downsample at once, they have separate
+state.
+
+The signals should be within 15 bits (-16384 to 16383), which leaves room for the overshoot of
+the filter and the sums in 32 bits.
+@tparam NUM_PAIRS the number of coefficient pairs, the delay is 2 * NUM_PAIRS - 1 samples at the
+higher rate.
+@tparam MAX_BLOCK the most samples, at the lower rate, that one call can take.
+*/
+template <uint8_t NUM_PAIRS, uint16_t MAX_BLOCK>
+class HalfbandFilter
+{
+
+public:
+	/** Constructor.
+	@param COEFFS NUM_PAIRS coefficients, outermost first, each twice the tap it stands for in Q1n14,
+	so they add up to 8192.  HALFBAND_6_PAIRS and HALFBAND_3_PAIRS are ready made.
+	*/
+	HalfbandFilter(const int16_t * COEFFS)
+	{
+		for (uint8_t j = 0; j < NUM_PAIRS; ++j) coeffs[j] = COEFFS[j];
+		memset(up_line, 0, sizeof(up_line));
+		memset(even_line, 0, sizeof(even_line));
+		memset(odd_line, 0, sizeof(odd_line));
+	}
+
+
+	/** Double the sample rate of a block.
+	@param in n samples.
+	@param out receives 2 * n samples.
+	@param n the number of input samples, up to MAX_BLOCK.
+	*/
+	void upsample(const int16_t * in, int16_t * out, unsigned int n)
+	{
+		memcpy(up_line + HISTORY, in, n * sizeof(int16_t));
+		for (unsigned int m = 0; m < n; ++m){
+			const int16_t * x = up_line + m + HISTORY; // x[0] is the newest sample
+			int32_t sum = 0;
+			for (uint8_t j = 0; j < NUM_PAIRS; ++j){
+				sum += (int32_t)coeffs[j] * (x[-(int)j] + x[(int)j - HISTORY]);
+			}
+			out[2 * m] = (int16_t)((sum + 8192) >> 14);
+			out[2 * m + 1] = x[1 - NUM_PAIRS];
+		}
+		memmove(up_line, up_line + n, HISTORY * sizeof(int16_t));
+	}
+
+
+	/** Halve the sample rate of a block.
+	@param in 2 * n samples.
+	@param out receives n samples.  It can be the same buffer as in.
+	@param n the number of output samples, up to MAX_BLOCK.
+	*/
+	void downsample(const int16_t * in, int16_t * out, unsigned int n)
+	{
+		for (unsigned int m = 0; m < n; ++m){
+			even_line[HISTORY + m] = in[2 * m];
+			odd_line[NUM_PAIRS + m] = in[2 * m + 1];
+		}
+		for (unsigned int m = 0; m < n; ++m){
+			const int16_t * e = even_line + m + HISTORY;
+			int32_t sum = (int32_t)odd_line[m] << 14; // the centre tap, 1/2
+			for (uint8_t j = 0; j < NUM_PAIRS; ++j){
+				sum += (int32_t)coeffs[j] * (e[-(int)j] + e[(int)j - HISTORY]);
+			}
+			out[m] = (int16_t)((sum + 16384) >> 15);
+		}
+		memmove(even_line, even_line + n, HISTORY * sizeof(int16_t));
+		memmove(odd_line, odd_line + n, NUM_PAIRS * sizeof(int16_t));
+	}
+
+
+private:
+	static const uint8_t HISTORY = 2 * NUM_PAIRS - 1;
+
+	int16_t coeffs[NUM_PAIRS];
+	int16_t up_line[HISTORY + MAX_BLOCK];
+	int16_t even_line[HISTORY + MAX_BLOCK];
+	int16_t odd_line[NUM_PAIRS + MAX_BLOCK];
+};
+
+#endif        //  #ifndef HALFBANDFILTER_H_
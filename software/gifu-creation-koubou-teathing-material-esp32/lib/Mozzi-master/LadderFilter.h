@@ -0,0 +1,177 @@
+/*
+ * LadderFilter.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons
+ * Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef LADDERFILTER_H_
+#define LADDERFILTER_H_
+
+#include "Arduino.h"
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "tables/onepole256_uint16.h"
+#include "tables/tanh256_int16.h"
+
+/** A resonant OTA ladder low pass filter, modelled on an LM13700 filter.
+
+Each pole is an OTA integrator: the OTA output current is tanh() of the difference between
+its input and the capacitor voltage, so each stage is
+y += g * tanh(in - y)
+with tanh() read from TANH256_DATA.  Four stages are cascaded and the output of the fourth is
+fed back to the input, inverted, for the resonance.  In 2 pole mode the output is taken from the
+second stage, with the feedback still from the fourth, so the resonance behaves the same.
+
+Compared to LowPassFilter, this saturates smoothly when driven or at high resonance instead of
+wrapping, and self-oscillates near the top of the resonance range.
+
+The cutoff coefficient g = 1 - exp(-2 * pi * cutoff / fs) is read from ONEPOLE256_DATA.
+Like StateVariableTuned, setCutoffFreq() only sets a target, next() jumps to it and process()
+interpolates to it across the block.
+
+A 16 bit full scale input drives the first stage into tanh(1), so use it with a 14 - 16 bit input.
+@note Timing: 4 interpolated tanh lookups (8 table reads) and 9 multiplies per sample, 5 of them
+32 x 32 bit to 64.  examples/10.Audio_Filters/LadderFilter_Benchmark measures it.
+*/
+class LadderFilter {
+
+public:
+  /** Constructor.
+   */
+  LadderFilter() : g(0), target_g(0), resonance_k(0), k(0), four_pole(true) {
+    y[0] = y[1] = y[2] = y[3] = 0;
+  }
+
+  /** Set the cutoff frequency.
+  @param cutoff_freq 0 - AUDIO_RATE/4 Hz, higher values are clipped to AUDIO_RATE/4.
+  */
+  inline void setCutoffFreq(unsigned int cutoff_freq) {
+    setCutoffFreq_Q16n16((Q16n16)cutoff_freq << 16);
+  }
+
+  /** Set the cutoff frequency, with a fractional part.
+  @param cutoff_freq 0 - AUDIO_RATE/4 Hz, in Q16n16 fixed point.
+  Higher values are clipped to AUDIO_RATE/4.
+  */
+  inline void setCutoffFreq_Q16n16(Q16n16 cutoff_freq) {
+    const Q16n16 max_freq = (Q16n16)(AUDIO_RATE / 4) << 16;
+    if (cutoff_freq > max_freq) cutoff_freq = max_freq;
+    // cutoff / AUDIO_RATE in Q0n32, 0 to 1/4
+    const uint32_t x = cutoff_freq << (16 - AUDIO_RATE_AS_LSHIFT);
+    const unsigned int index = x >> 22;
+    if (index >= ONEPOLE256_NUM_CELLS) {
+      target_g = FLASH_OR_RAM_READ<const uint16_t>(ONEPOLE256_DATA + ONEPOLE256_NUM_CELLS);
+    } else {
+      const uint32_t fraction = (x >> 6) & 0xffff;
+      const int32_t a = FLASH_OR_RAM_READ<const uint16_t>(ONEPOLE256_DATA + index);
+      const int32_t b = FLASH_OR_RAM_READ<const uint16_t>(ONEPOLE256_DATA + index + 1);
+      target_g = a + (int32_t)(((b - a) * fraction) >> 16);
+    }
+    updateFeedback();
+  }
+
+  /** Set the resonance.
+  @param resonance 0 - 255, the filter starts to self-oscillate near 255.
+  */
+  inline void setResonance(uint8_t resonance) {
+    resonance_k = (int32_t)resonance * 66; // Q4n12, 0 to 4.1
+    updateFeedback();
+  }
+
+  /** Choose between the 4 pole (24dB/oct) and 2 pole (12dB/oct) response.
+  @param poles 4 or 2.
+  */
+  inline void setPoles(uint8_t poles) {
+    four_pole = (poles != 2);
+  }
+
+  /** Calculate the next sample, given an input signal.
+  This uses the last cutoff set, without interpolation.
+  @param input the signal input, up to 16 bits.
+  @return the signal output.
+  */
+  inline int next(int input) {
+    g = target_g;
+    return tick(input, g);
+  }
+
+  /** Filter a block of audio, interpolating the cutoff coefficient from the
+  last one used to the one set by the last setCutoffFreq() across the block.
+  @param in the signal input, n samples.
+  @param out receives the signal output, n samples.  It can be the same buffer as in.
+  @param n the number of samples.
+  */
+  void process(const int16_t * in, int16_t * out, unsigned int n) {
+    if (n == 0) return;
+    const int32_t step = (target_g - g) / (int32_t)n;
+    int32_t coeff = g;
+    for (unsigned int i = 0; i < n; ++i) {
+      coeff += step;
+      const int sample = tick(in[i], coeff);
+      out[i] = (int16_t) constrain(sample, -32768, 32767);
+    }
+    g = target_g;
+  }
+
+private:
+  // the stages are kept 8 bits above the audio, so 1.0 is 1 << 23
+  static const uint8_t STATE_SHIFT = 8;
+  static const int32_t TANH_RANGE = (int32_t)4 << 23; // the table covers -4 to 4
+  static const uint8_t TANH_CELL_SHIFT = 18;          // 2 * TANH_RANGE / 256 cells
+
+  int32_t y[4];
+  int32_t g;         // cutoff coefficient in use, Q0n16
+  int32_t target_g;  // cutoff coefficient from the last setCutoffFreq(), Q0n16
+  int32_t resonance_k; // resonance from setResonance(), Q4n12
+  int32_t k;           // feedback, resonance_k compensated for the cutoff, Q4n12
+  bool four_pole;
+
+  /* The feedback comes from the previous sample's output, and that extra delay needs more
+  feedback for the same resonance as the cutoff rises: 4 at low cutoffs, 6 at AUDIO_RATE/16 and 13
+  at AUDIO_RATE/6.  1 + g + g^2 + 4 * g^3 follows that within 10%, so the resonance (and the point
+  where it self-oscillates) stays about the same across the range. */
+  inline void updateFeedback() {
+    const uint32_t g2 = ((uint32_t)target_g * target_g) >> 16;
+    const uint32_t g3 = (g2 * target_g) >> 16;
+    const uint32_t compensation = 65536 + target_g + g2 + (g3 << 2); // Q16n16
+    k = (int32_t)(((uint32_t)resonance_k * compensation) >> 16);
+  }
+
+  /* tanh of a state value, returned as a state value */
+  static inline int32_t saturate(int32_t x) {
+    const int32_t offset = x + TANH_RANGE;
+    if (offset <= 0) return (int32_t)FLASH_OR_RAM_READ<const int16_t>(TANH256_DATA) << STATE_SHIFT;
+    const uint32_t index = (uint32_t)offset >> TANH_CELL_SHIFT;
+    if (index >= TANH256_NUM_CELLS) return (int32_t)FLASH_OR_RAM_READ<const int16_t>(TANH256_DATA + TANH256_NUM_CELLS) << STATE_SHIFT;
+    const int32_t fraction = offset & ((1L << TANH_CELL_SHIFT) - 1);
+    const int32_t a = FLASH_OR_RAM_READ<const int16_t>(TANH256_DATA + index);
+    const int32_t b = FLASH_OR_RAM_READ<const int16_t>(TANH256_DATA + index + 1);
+    return (a << STATE_SHIFT) + (((b - a) * fraction) >> (TANH_CELL_SHIFT - STATE_SHIFT));
+  }
+
+  inline int32_t stage(int32_t & state, int32_t in, int32_t coeff) {
+    state += (int32_t)(((int64_t)coeff * saturate(in - state)) >> 16);
+    return state;
+  }
+
+  inline int tick(int input, int32_t coeff) {
+    const int32_t u = ((int32_t)input << STATE_SHIFT) - (int32_t)(((int64_t)k * y[3]) >> 12);
+    const int32_t s1 = stage(y[0], u, coeff);
+    const int32_t s2 = stage(y[1], s1, coeff);
+    const int32_t s3 = stage(y[2], s2, coeff);
+    stage(y[3], s3, coeff);
+    return (four_pole ? y[3] : s2) >> STATE_SHIFT;
+  }
+};
+
+/**
+@example 10.Audio_Filters/LowPassFilter/LowPassFilter.ino
+LadderFilter can be swapped in for LowPassFilter in this example, with setCutoffFreq()
+in Hz and setResonance() called separately.
+*/
+
+#endif /* LADDERFILTER_H_ */
@@ -15,6 +15,7 @@
 
 #include "IntegerType.h"
 #include "AudioOutput.h"
+#include "mozzi_mult.h"
 
 
 
@@ -140,7 +141,11 @@ private:
   inline typename IntegerType<sizeof(AudioOutputStorage_t)+sizeof(su)-1>::signed_type ifxmul(typename IntegerType<sizeof(AudioOutputStorage_t )+sizeof(su)-1>::signed_type a, su b) { return ((a * b) >> FX_SHIFT); } 
 
   // multiply two fixed point numbers (returns fixed point)
-  inline typename IntegerType<sizeof(AudioOutputStorage_t)+sizeof(AudioOutputStorage_t)>::signed_type fxmul(typename IntegerType<sizeof(AudioOutputStorage_t)+sizeof(AudioOutputStorage_t)>::signed_type a, typename IntegerType<sizeof(AudioOutputStorage_t)+sizeof(su)-1>::signed_type b) { return ((a * b) >> FX_SHIFT); }
+  // where a is 64 bits, the values fit in 32, and a 32 x 32 multiply is much faster than a 64 bit one
+  inline typename IntegerType<sizeof(AudioOutputStorage_t)+sizeof(AudioOutputStorage_t)>::signed_type fxmul(typename IntegerType<sizeof(AudioOutputStorage_t)+sizeof(AudioOutputStorage_t)>::signed_type a, typename IntegerType<sizeof(AudioOutputStorage_t)+sizeof(su)-1>::signed_type b) {
+    if (sizeof(a) == 8 && sizeof(b) <= 4) return mult_s32x32_shr<(sizeof(su) << 3)>((int32_t)a, (int32_t)b);
+    return ((a * b) >> FX_SHIFT);
+  }
 };
 
 typedef LowPassFilterNbits<> LowPassFilter;
@@ -0,0 +1,197 @@
+/*
+ * MorphOscil.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons
+ * Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef MORPHOSCIL_H_
+#define MORPHOSCIL_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+#include "Oscil.h"
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+
+/**
+MorphOscil plays a bank of wavetables of the same length with one phase, and crossfades
+between neighbouring tables with a morph position, for smooth changes of timbre instead of the
+hard switch of Oscil::setTable().
+
+The morph position is Q8n8: the integer part picks a table and the fraction fades towards
+the next one, so with 4 tables the range is 0 to 3 << 8.  Each sample reads the same cell from
+the two tables and mixes them, so it costs two reads and one multiply.
+
+The morph can be set per sample with next(morph), so it can be modulated at audio rate; going
+from one pair of tables to the next is seamless because the fade is complete at the boundary.
+From control rate, setMorph(morph, num_steps) ramps to the new position over num_steps
+calls to next(), like Line::set(), and process() ramps across a block, so there is no zipper noise.
+
+Tables of different lengths can be resampled to a common one with extras/python/resample_table.py,
+as was done for tables/chum9_2048_int8.h and tables/chum78_2048_int8.h to go with
+saw2048, square_no_alias_2048 and triangle2048.
+@tparam NUM_TABLE_CELLS the length of every table in the bank, a power of two.
+@tparam UPDATE_RATE AUDIO_RATE or CONTROL_RATE, as for Oscil.
+*/
+template <uint16_t NUM_TABLE_CELLS, uint16_t UPDATE_RATE>
+class MorphOscil
+{
+	typedef uint32_t Q8n16; // morph position with 16 bits of fraction
+
+public:
+	/** Constructor.
+	@param TABLES an array of pointers to the tables, which must outlive the MorphOscil.
+	@param NUM_TABLES the number of tables, at least 2.
+	*/
+	MorphOscil(const int8_t * const * TABLES, uint8_t NUM_TABLES):
+		phase_fractional(0), phase_increment_fractional(0), morph(0), morph_target(0), morph_step(0), morph_steps_left(0)
+	{
+		setTables(TABLES, NUM_TABLES);
+	}
+
+
+	/** Change the bank of tables.
+	@param TABLES an array of pointers to the tables.
+	@param NUM_TABLES the number of tables, at least 2.
+	*/
+	void setTables(const int8_t * const * TABLES, uint8_t NUM_TABLES)
+	{
+		tables = TABLES;
+		max_morph = (Q8n16)(NUM_TABLES - 1) << 16;
+		if (morph > max_morph) morph = max_morph;
+	}
+
+
+	/** Set the frequency.
+	@param frequency in Hz, as for Oscil::setFreq(int).
+	*/
+	inline
+	void setFreq(int frequency)
+	{
+		phase_increment_fractional = ((unsigned long)frequency) * ((OSCIL_F_BITS_AS_MULTIPLIER*NUM_TABLE_CELLS)/UPDATE_RATE);
+	}
+
+
+	/** Set the frequency.
+	@param frequency in Hz, as for Oscil::setFreq(float).
+	*/
+	inline
+	void setFreq(float frequency)
+	{
+		phase_increment_fractional = (unsigned long)((((float)NUM_TABLE_CELLS * frequency)/UPDATE_RATE) * OSCIL_F_BITS_AS_MULTIPLIER);
+	}
+
+
+	/** Set the frequency in Q16n16 fixed point, as for Oscil::setFreq_Q16n16().
+	@param frequency in Hz.
+	*/
+	inline
+	void setFreq_Q16n16(Q16n16 frequency)
+	{
+		if (NUM_TABLE_CELLS >= UPDATE_RATE) {
+			phase_increment_fractional = ((unsigned long)frequency) * (NUM_TABLE_CELLS/UPDATE_RATE);
+		} else {
+			phase_increment_fractional = ((unsigned long)frequency) / (UPDATE_RATE/NUM_TABLE_CELLS);
+		}
+	}
+
+
+	/** Set the morph position, ramping to it over num_steps calls to next().
+	@param morph_position Q8n8, from 0 to (NUM_TABLES - 1) << 8.
+	@param num_steps how many samples to take to get there.  Use UPDATE_RATE / CONTROL_RATE
+	when calling from updateControl().  1 jumps straight there.
+	*/
+	inline
+	void setMorph(Q8n8 morph_position, unsigned int num_steps = 1)
+	{
+		Q8n16 target = (Q8n16)morph_position << 8;
+		if (target > max_morph) target = max_morph;
+		if (num_steps < 1) num_steps = 1;
+		morph_step = ((int32_t)target - (int32_t)morph) / (int32_t)num_steps;
+		morph_target = target;
+		morph_steps_left = num_steps;
+	}
+
+
+	/** Updates the phase and the morph ramp, and returns the next sample.
+	@return the next sample.
+	*/
+	inline
+	int8_t next()
+	{
+		if (morph_steps_left) {
+			morph = (--morph_steps_left) ? (Q8n16)((int32_t)morph + morph_step) : morph_target;
+		}
+		return readMorph(morph);
+	}
+
+
+	/** Updates the phase and returns the next sample at the given morph position, for audio rate
+	morph modulation.  This doesn't change the position set by setMorph().
+	@param morph_position Q8n8, from 0 to (NUM_TABLES - 1) << 8.
+	@return the next sample.
+	*/
+	inline
+	int8_t next(Q8n8 morph_position)
+	{
+		return readMorph((Q8n16)morph_position << 8);
+	}
+
+
+	/** Fill a block with samples, ramping the morph position from where it is to the position
+	set by the last setMorph() across the block, whatever num_steps was.
+	@param out receives n samples.
+	@param n the number of samples.
+	*/
+	void process(int8_t * out, unsigned int n)
+	{
+		if (n == 0) return;
+		if (morph_steps_left) {
+			morph_step = ((int32_t)morph_target - (int32_t)morph) / (int32_t)n;
+		} else {
+			morph_step = 0;
+		}
+		int32_t m = morph;
+		for (unsigned int i = 0; i < n; ++i){
+			m += morph_step;
+			out[i] = readMorph((Q8n16)m);
+		}
+		if (morph_steps_left) morph = morph_target;
+		morph_steps_left = 0;
+	}
+
+
+private:
+	const int8_t * const * tables;
+	unsigned long phase_fractional;
+	volatile unsigned long phase_increment_fractional;
+	Q8n16 morph, morph_target, max_morph;
+	int32_t morph_step;
+	unsigned int morph_steps_left;
+
+
+	inline
+	int8_t readMorph(Q8n16 m)
+	{
+		if (m > max_morph) m = max_morph;
+		// the last table is reached with a full fade from the one before it
+		uint8_t first = m >> 16;
+		if (first >= (max_morph >> 16)) first = (max_morph >> 16) - 1;
+		const int16_t fade = (m - ((Q8n16)first << 16)) >> 8; // 0 to 256
+
+		phase_fractional += phase_increment_fractional;
+		const unsigned int index = (phase_fractional >> OSCIL_F_BITS) & (NUM_TABLE_CELLS - 1);
+		const int16_t a = FLASH_OR_RAM_READ<const int8_t>(tables[first] + index);
+		const int16_t b = FLASH_OR_RAM_READ<const int8_t>(tables[first + 1] + index);
+		return (int8_t)(a + (((b - a) * fade) >> 8));
+	}
+};
+
+#endif /* MORPHOSCIL_H_ */
@@ -0,0 +1,252 @@
+/*
+ * Oscil16.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef OSCIL16_H_
+#define OSCIL16_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+#include "Oscil.h"
+
+/**
+Oscil16 is an Oscil for int16_t tables, for the 16 bit output modes (PT8211_DAC and PDM_VIA_I2S on
+the ESP32, or EXTERNAL_AUDIO_OUTPUT).  It plays tables like COS4096X16_DATA or
+WaveTable<WAVE_SINE, 2048, int16_t>::DATA, and returns the full 16 bits, for MonoOutput::from16Bit().
+
+With INTERPOLATE true, the output is interpolated between the two cells either side of the phase,
+with the 16 bit fraction of the phase.  That takes a second table read and a multiply for each
+sample, but the error of a 2048 cell sine goes from around -55dB, which is heard well above the floor
+of a 16 bit DAC, to around -90dB.
+
+The frequency is set the same way as for Oscil.
+@tparam NUM_TABLE_CELLS the length of the table, a power of 2.
+@tparam UPDATE_RATE AUDIO_RATE if the Oscil16 is updated in updateAudio(), or CONTROL_RATE if
+it's updated in updateControl().
+@tparam INTERPOLATE true to interpolate between cells.
+*/
+template <uint16_t NUM_TABLE_CELLS, uint16_t UPDATE_RATE, bool INTERPOLATE = false>
+class Oscil16
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of the int16_t array the Oscil16 will be using.
+	*/
+	Oscil16(const int16_t * TABLE_NAME):phase_fractional(0), phase_increment_fractional(0), table(TABLE_NAME)
+	{}
+
+
+	/** Constructor, without a table.  Set one with setTable() before playing.
+	*/
+	Oscil16():phase_fractional(0), phase_increment_fractional(0), table(0)
+	{}
+
+
+	/** Updates the phase according to the current frequency and returns the sample at the new phase position.
+	@return the next sample, 16 bits.
+	*/
+	inline
+	int16_t next()
+	{
+		phase_fractional += phase_increment_fractional;
+		return read(phase_fractional);
+	}
+
+
+	/** Fill a block with the next n samples.  This gives the same output as n calls of next(), with
+	the phase kept in a register across the block.
+	@param out receives n samples.
+	@param n the number of samples.
+	*/
+	void render(int16_t * out, unsigned int n)
+	{
+		unsigned long phase = phase_fractional;
+		const unsigned long increment = phase_increment_fractional;
+		for (unsigned int i = 0; i < n; ++i){
+			phase += increment;
+			out[i] = read(phase);
+		}
+		phase_fractional = phase;
+	}
+
+
+	/** Change the sound table which will be played.
+	@param TABLE_NAME the name of an int16_t array of the same length.
+	*/
+	void setTable(const int16_t * TABLE_NAME)
+	{
+		table = TABLE_NAME;
+	}
+
+
+	/** Set the phase.
+	@param phase a position in the table.
+	*/
+	void setPhase(unsigned int phase)
+	{
+		phase_fractional = (unsigned long)phase << OSCIL_F_BITS;
+	}
+
+
+	/** Set the phase in fractional format.  Might be useful with getPhaseFractional().
+	@param phase a position in the table, shifted left by OSCIL_F_BITS.
+	*/
+	void setPhaseFractional(unsigned long phase)
+	{
+		phase_fractional = phase;
+	}
+
+
+	/** Get the phase in fractional format.
+	@return position in the table, shifted left by OSCIL_F_BITS.
+	*/
+	unsigned long getPhaseFractional()
+	{
+		return phase_fractional;
+	}
+
+
+	/** Returns the next sample given a phase modulation value, as Oscil::phMod().
+	@param phmod_proportion a Q15n16 phase modulation, where the n16 part represents almost -1 to almost
+	1, modulating the phase by one whole table length in each direction.
+	@return the next sample, 16 bits.
+	*/
+	inline
+	int16_t phMod(Q15n16 phmod_proportion)
+	{
+		phase_fractional += phase_increment_fractional;
+		return read(phase_fractional + (phmod_proportion * NUM_TABLE_CELLS));
+	}
+
+
+	/** Set the frequency with an unsigned int, as Oscil::setFreq(int).
+	@param frequency to play the table.
+	*/
+	inline
+	void setFreq(int frequency)
+	{
+		phase_increment_fractional = ((unsigned long)frequency) * ((OSCIL_F_BITS_AS_MULTIPLIER*NUM_TABLE_CELLS)/UPDATE_RATE);
+	}
+
+
+	/** Set the frequency with a float.
+	@param frequency to play the table.
+	*/
+	inline
+	void setFreq(float frequency)
+	{
+		phase_increment_fractional = (unsigned long)((((float)NUM_TABLE_CELLS * frequency)/UPDATE_RATE) * OSCIL_F_BITS_AS_MULTIPLIER);
+	}
+
+
+	/** Set the frequency in Q24n8, as Oscil::setFreq_Q24n8().
+	@param frequency in Q24n8 fixed-point number format.
+	*/
+	inline
+	void setFreq_Q24n8(Q24n8 frequency)
+	{
+		if ((256UL*NUM_TABLE_CELLS) >= UPDATE_RATE) {
+			phase_increment_fractional = ((unsigned long)frequency) * ((256UL*NUM_TABLE_CELLS)/UPDATE_RATE);
+		} else {
+			phase_increment_fractional = ((unsigned long)frequency) / (UPDATE_RATE/(256UL*NUM_TABLE_CELLS));
+		}
+	}
+
+
+	/** Set the frequency in Q16n16, as Oscil::setFreq_Q16n16().
+	@param frequency in Q16n16 fixed-point number format.
+	*/
+	inline
+	void setFreq_Q16n16(Q16n16 frequency)
+	{
+		if (NUM_TABLE_CELLS >= UPDATE_RATE) {
+			phase_increment_fractional = ((unsigned long)frequency) * (NUM_TABLE_CELLS/UPDATE_RATE);
+		} else {
+			phase_increment_fractional = ((unsigned long)frequency) / (UPDATE_RATE/NUM_TABLE_CELLS);
+		}
+	}
+
+
+	/** Returns the sample at the given table index.
+	@param index the index rolls back around to 0 if it's larger than the table size.
+	@return the sample at the given table index.
+	*/
+	inline
+	int16_t atIndex(unsigned int index)
+	{
+		return FLASH_OR_RAM_READ<const int16_t>(table + (index & (NUM_TABLE_CELLS - 1)));
+	}
+
+
+	/** Calculate a phase increment for setPhaseInc(), as Oscil::phaseIncFromFreq().
+	@param frequency for which you want to calculate a phase increment value.
+	@return the phase increment value which will produce a given frequency.
+	*/
+	inline
+	unsigned long phaseIncFromFreq(int frequency)
+	{
+		return ((unsigned long)frequency) * ((OSCIL_F_BITS_AS_MULTIPLIER*NUM_TABLE_CELLS)/UPDATE_RATE);
+	}
+
+
+	/** Set the frequency from a midi note number, with fractions of a note.  This takes a few
+	multiplies and one small table read, with no division, so pitch can be modulated at audio rate,
+	for vibrato or glides which are even in pitch.  Unlike setFreq_Q16n16(Q16n16_mtof()), which
+	interpolates in straight lines between the notes (up to 0.7 cents out), it is within 0.03 cents
+	all the way, apart from the rounding of the phase increment.
+	@param midi_note a midi note number in Q16n16, for example Q8n0_to_Q16n16(69) for A4, 440 Hz.
+	*/
+	inline
+	void setPhaseIncFromPitch(Q16n16 midi_note)
+	{
+		// octaves from A4, (midi_note - 69) / 12, with 1/12 in Q0n32
+		const int32_t octaves = mult_s32x32_h32((int32_t)midi_note - ((int32_t)69 << 16), 357913941);
+		const int16_t whole = (int16_t)(octaves >> 16);
+		const uint64_t increment = (uint64_t)A440_PHASE_INC * Q0n16_exp2_Q2n30((Q0n16)octaves);
+		phase_increment_fractional = (unsigned long)(increment >> (30 - whole));
+	}
+
+
+	/** Set a specific phase increment.  See phaseIncFromFreq().
+	@param phaseinc_fractional a phase increment value as calculated by phaseIncFromFreq().
+	*/
+	inline
+	void setPhaseInc(unsigned long phaseinc_fractional)
+	{
+		phase_increment_fractional = phaseinc_fractional;
+	}
+
+
+private:
+	static const uint32_t A440_PHASE_INC = (uint32_t)((440ULL * OSCIL_F_BITS_AS_MULTIPLIER * NUM_TABLE_CELLS + UPDATE_RATE / 2) / UPDATE_RATE);
+
+	unsigned long phase_fractional;
+	unsigned long phase_increment_fractional;
+	const int16_t * table;
+
+
+	/* the sample at a phase, interpolated if INTERPOLATE */
+	inline
+	int16_t read(unsigned long phase)
+	{
+		const unsigned int index = (phase >> OSCIL_F_BITS) & (NUM_TABLE_CELLS - 1);
+		const int32_t a = FLASH_OR_RAM_READ<const int16_t>(table + index);
+		if (!INTERPOLATE) return a;
+		const int32_t b = FLASH_OR_RAM_READ<const int16_t>(table + ((index + 1) & (NUM_TABLE_CELLS - 1)));
+		// 15 bits of the fraction, so the difference times the fraction stays inside 32 bits
+		const int32_t fraction = (phase & (OSCIL_F_BITS_AS_MULTIPLIER - 1)) >> 1;
+		return (int16_t)(a + (((b - a) * fraction) >> 15));
+	}
+
+};
+
+#endif /* OSCIL16_H_ */
@@ -0,0 +1,196 @@
+/*
+ * OscilBank.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons
+ * Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef OSCILBANK_H_
+#define OSCILBANK_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+#include "Oscil.h"
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "mozzi_rand.h"
+
+/**
+OscilBank plays one wavetable with NUM_OSCILS phases and sums them, for unison and
+"supersaw" sounds which would otherwise need a row of Oscils added up in updateAudio(),
+as in the Detuned_Beats_Wash example.
+
+The phases and phase increments are kept in two arrays, and process() renders one oscillator
+at a time across the whole block, adding into the output, so the inner loop only holds one phase,
+one increment and the table pointer.  That is a plain strided loop the compiler can unroll (or
+vectorise where there are gathers), and it is where the saving over separate Oscils comes from.
+
+setFreq() sets the centre frequency, and setDetune() spreads the oscillators evenly around it
+in proportion to the frequency, so the detune sounds the same on every note.  Each oscillator
+can also be set on its own with setFreq_Q16n16(oscil, frequency).  The phases start at random
+positions so the oscillators don't all line up at the start of a note.
+
+The output is the sum of NUM_OSCILS 8 bit samples, so it has log2(NUM_OSCILS) more bits:
+-896 to 889 for 7 oscillators.
+@tparam NUM_TABLE_CELLS the length of the table, a power of two, as for Oscil.
+@tparam UPDATE_RATE AUDIO_RATE or CONTROL_RATE, as for Oscil.
+@tparam NUM_OSCILS how many oscillators to play, 7 is the classic supersaw.
+*/
+template <uint16_t NUM_TABLE_CELLS, uint16_t UPDATE_RATE, uint8_t NUM_OSCILS>
+class OscilBank
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of the array the oscillators will be using.
+	*/
+	OscilBank(const int8_t * TABLE_NAME): table(TABLE_NAME), centre_increment(0), detune(0)
+	{
+		for (uint8_t i = 0; i < NUM_OSCILS; ++i){
+			phase_fractional[i] = xorshift96();
+			phase_increment_fractional[i] = 0;
+		}
+	}
+
+
+	/** Change the table the oscillators play.
+	@param TABLE_NAME the name of the array.
+	*/
+	void setTable(const int8_t * TABLE_NAME)
+	{
+		table = TABLE_NAME;
+	}
+
+
+	/** Set the centre frequency of the bank.
+	@param frequency in Hz, as for Oscil::setFreq(int).
+	*/
+	inline
+	void setFreq(int frequency)
+	{
+		centre_increment = ((unsigned long)frequency) * ((OSCIL_F_BITS_AS_MULTIPLIER*NUM_TABLE_CELLS)/UPDATE_RATE);
+		updateIncrements();
+	}
+
+
+	/** Set the centre frequency of the bank.
+	@param frequency in Hz, as for Oscil::setFreq(float).
+	*/
+	inline
+	void setFreq(float frequency)
+	{
+		centre_increment = (unsigned long)((((float)NUM_TABLE_CELLS * frequency)/UPDATE_RATE) * OSCIL_F_BITS_AS_MULTIPLIER);
+		updateIncrements();
+	}
+
+
+	/** Set the centre frequency of the bank in Q16n16 fixed point, as for Oscil::setFreq_Q16n16().
+	@param frequency in Hz.
+	*/
+	inline
+	void setFreq_Q16n16(Q16n16 frequency)
+	{
+		centre_increment = toIncrement(frequency);
+		updateIncrements();
+	}
+
+
+	/** Set the frequency of one oscillator, overriding the detune until the next setFreq() or setDetune().
+	@param oscil which oscillator, from 0 to NUM_OSCILS - 1.
+	@param frequency in Hz, in Q16n16 fixed point.
+	*/
+	inline
+	void setFreq_Q16n16(uint8_t oscil, Q16n16 frequency)
+	{
+		phase_increment_fractional[oscil] = toIncrement(frequency);
+	}
+
+
+	/** Spread the oscillators around the centre frequency.
+	@param detune_amount from 0 (all in unison) to 255, where the outermost oscillators are
+	about 2 semitones either side of the centre.  Around 20 is a typical supersaw.
+	*/
+	inline
+	void setDetune(uint8_t detune_amount)
+	{
+		detune = detune_amount;
+		updateIncrements();
+	}
+
+
+	/** Updates the phases and returns the sum of the oscillators.
+	@return the next sample, NUM_OSCILS times the range of the table.
+	*/
+	inline
+	int next()
+	{
+		int sum = 0;
+		for (uint8_t i = 0; i < NUM_OSCILS; ++i){
+			phase_fractional[i] += phase_increment_fractional[i];
+			sum += FLASH_OR_RAM_READ<const int8_t>(table + ((phase_fractional[i] >> OSCIL_F_BITS) & (NUM_TABLE_CELLS - 1)));
+		}
+		return sum;
+	}
+
+
+	/** Fill a block with the summed oscillators.
+	@param out receives n samples.
+	@param n the number of samples.
+	*/
+	void process(int16_t * out, unsigned int n)
+	{
+		for (unsigned int j = 0; j < n; ++j) out[j] = 0;
+		for (uint8_t i = 0; i < NUM_OSCILS; ++i){
+			const int8_t * const t = table;
+			unsigned long phase = phase_fractional[i];
+			const unsigned long increment = phase_increment_fractional[i];
+			for (unsigned int j = 0; j < n; ++j){
+				phase += increment;
+				out[j] += FLASH_OR_RAM_READ<const int8_t>(t + ((phase >> OSCIL_F_BITS) & (NUM_TABLE_CELLS - 1)));
+			}
+			phase_fractional[i] = phase;
+		}
+	}
+
+
+private:
+	unsigned long phase_fractional[NUM_OSCILS];
+	unsigned long phase_increment_fractional[NUM_OSCILS];
+	const int8_t * table;
+	unsigned long centre_increment;
+	uint8_t detune;
+
+
+	static inline
+	unsigned long toIncrement(Q16n16 frequency)
+	{
+		if (NUM_TABLE_CELLS >= UPDATE_RATE) {
+			return ((unsigned long)frequency) * (NUM_TABLE_CELLS/UPDATE_RATE);
+		} else {
+			return ((unsigned long)frequency) / (UPDATE_RATE/NUM_TABLE_CELLS);
+		}
+	}
+
+
+	/* oscillator i is offset by (2i - (NUM_OSCILS - 1)) / (NUM_OSCILS - 1) * detune / 2048 of the centre */
+	void updateIncrements()
+	{
+		if (NUM_OSCILS == 1) {
+			phase_increment_fractional[0] = centre_increment;
+			return;
+		}
+		const int64_t spread = (int64_t)centre_increment * detune;
+		for (uint8_t i = 0; i < NUM_OSCILS; ++i){
+			const int32_t position = 2 * i - (NUM_OSCILS - 1);
+			phase_increment_fractional[i] = centre_increment + (int32_t)((spread * position) / ((int32_t)(NUM_OSCILS - 1) << 11));
+		}
+	}
+};
+
+#endif /* OSCILBANK_H_ */
@@ -0,0 +1,263 @@
+/*
+ * PT2399Echo.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef PT2399ECHO_H_
+#define PT2399ECHO_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "SilenceDetector.h"
+#include "tables/onepole256_uint16.h"
+
+/** An echo in the style of the PT2399 delay chip, stored in 8 bit mu-law cells.
+
+The delay line holds one byte per cell, mu-law companded, so it is twice as long as an
+AudioDelayFeedback in the same memory, with about 13 bits of dynamic range.  The companding
+noise is quiet on quiet signals, like the PT2399's own companding.
+
+The PT2399 gets darker as the delay gets longer, because its clock slows down.  Here a one pole
+lowpass in the feedback path follows the delay time: its cutoff is about 300 / delay_cells of the
+sample rate, so 10kHz at 30ms and 1kHz at 300ms.  Each repeat goes through it again.
+
+setDelayTimeCells(), setFeedbackLevel() and setMix() can be called at control rate.  They set targets
+which are followed with a one pole smoother on every sample, so there are no clicks: when the delay
+time changes the read position glides, and the repeats bend in pitch like the PT2399 does.
+
+The delay line is mu-law rather than ADPCM so that the read position can move freely: ADPCM cells
+can only be decoded in order from a known starting point.
+
+When the input and the echo have been quiet for the length of the buffer, the echo stops running
+and only the dry part of the input is returned, until input comes again, see isSilent().
+
+@tparam NUM_BUFFER_SAMPLES the length of the delay buffer in cells (bytes), a power of two.
+For example 16384 cells are 16k of RAM and 0.5s at an AUDIO_RATE of 32768.
+*/
+template <uint16_t NUM_BUFFER_SAMPLES>
+class PT2399Echo
+{
+
+public:
+	/** Constructor.
+	@param delaytime_cells delay time expressed in cells, num_cells = delay_seconds * AUDIO_RATE.
+	*/
+	PT2399Echo(uint16_t delaytime_cells = NUM_BUFFER_SAMPLES / 2): write_pos(0), lowpass(0), silence(NUM_BUFFER_SAMPLES, 4)
+	{
+		clear();
+		setDelayTimeCells(delaytime_cells);
+		setFeedbackLevel(128);
+		setMix(128);
+		delay = target_delay;
+		feedback = target_feedback;
+		mix = target_mix;
+	}
+
+
+	/** Set the delay time.  The read position glides to the new time.
+	@param delaytime_cells delay time expressed in cells, up to NUM_BUFFER_SAMPLES - 2.
+	*/
+	inline
+	void setDelayTimeCells(uint16_t delaytime_cells)
+	{
+		if (delaytime_cells < 1) delaytime_cells = 1;
+		if (delaytime_cells > NUM_BUFFER_SAMPLES - 2) delaytime_cells = NUM_BUFFER_SAMPLES - 2;
+		target_delay = (Q15n16)delaytime_cells << 16;
+
+		// cutoff / AUDIO_RATE = 300 / delaytime_cells, in Q0n22, clipped to 1/4
+		uint32_t x = ((uint32_t)300 << 22) / delaytime_cells;
+		if (x >= ((uint32_t)1 << 20)) {
+			damping = FLASH_OR_RAM_READ<const uint16_t>(ONEPOLE256_DATA + ONEPOLE256_NUM_CELLS) >> 1;
+			return;
+		}
+		const unsigned int index = x >> 12;
+		const uint32_t fraction = x & 0xfff;
+		const int32_t a = FLASH_OR_RAM_READ<const uint16_t>(ONEPOLE256_DATA + index);
+		const int32_t b = FLASH_OR_RAM_READ<const uint16_t>(ONEPOLE256_DATA + index + 1);
+		damping = (a + (int32_t)(((b - a) * (int32_t)fraction) >> 12)) >> 1;
+	}
+
+
+	/** Set the feedback level.
+	@param feedback_level from 0 to 255 (a little less than 1).
+	*/
+	inline
+	void setFeedbackLevel(uint8_t feedback_level)
+	{
+		target_feedback = (int32_t)feedback_level << 16;
+	}
+
+
+	/** Set the mix between the dry input and the echo.
+	@param mix_level from 0 (only the input) to 255 (only the echo).
+	*/
+	inline
+	void setMix(uint8_t mix_level)
+	{
+		target_mix = (int32_t)mix_level << 16;
+	}
+
+
+	/** Input a value to the delay and return the input mixed with the echo.
+	@param input the signal input, up to 16 bits.
+	@return the mixed output.
+	*/
+	inline
+	int next(int input)
+	{
+		if (silence.isSilent()) {
+			if (silence.isQuiet(input)) return dry(input);
+			clear();
+		}
+		const int out = tick(input);
+		silence.update(silence.isQuiet(input) && silence.isQuiet(lowpass));
+		return out;
+	}
+
+
+	/** Process a block of audio.
+	@param in the signal input, n samples.
+	@param out receives the mixed output, n samples.  It can be the same buffer as in.
+	@param n the number of samples.
+	*/
+	void process(const int16_t * in, int16_t * out, unsigned int n)
+	{
+		const bool quiet_in = silence.isQuiet(in, n);
+		if (silence.isSilent()) {
+			if (quiet_in) {
+				for (unsigned int i = 0; i < n; ++i){
+					out[i] = (int16_t) dry(in[i]);
+				}
+				return;
+			}
+			clear();
+		}
+		bool quiet_echo = true;
+		for (unsigned int i = 0; i < n; ++i){
+			out[i] = (int16_t) constrain(tick(in[i]), -32768, 32767);
+			quiet_echo = quiet_echo && silence.isQuiet(lowpass);
+		}
+		silence.update(quiet_in && quiet_echo, n);
+	}
+
+
+	/** Set how loud the input and echo can be and still count as silence.
+	@param threshold the largest sample either way from 0, 4 by default.  0 waits for exact silence.
+	*/
+	inline
+	void setSilenceThreshold(int threshold)
+	{
+		silence.setThreshold(threshold);
+	}
+
+
+	/** Tells if the echo is asleep: the input and echo have been quiet for the length of the
+	buffer, and next() and process() only return the dry input, without running the delay.
+	*/
+	inline
+	bool isSilent() const
+	{
+		return silence.isSilent();
+	}
+
+
+private:
+	static const uint8_t SMOOTH_SHIFT = 10; // about 30ms at 32768Hz
+	static const Q15n16 MAX_GLIDE = (Q15n16)1 << 15;
+
+	uint8_t delay_array[NUM_BUFFER_SAMPLES];
+	uint16_t write_pos;
+	Q15n16 delay, target_delay;              // in cells
+	int32_t feedback, target_feedback;       // Q8n16, 0 to 255
+	int32_t mix, target_mix;                 // Q8n16, 0 to 255
+	int32_t damping;                         // Q0n15
+	int32_t lowpass;
+	SilenceDetector silence;
+
+
+	/* an empty delay line, so an echo woken from silence does not repeat what was left in it */
+	void clear()
+	{
+		memset(delay_array, encode(0), sizeof(delay_array));
+		lowpass = 0;
+	}
+
+
+	/* the output while asleep, with the settings moved straight to their targets */
+	inline
+	int dry(int input)
+	{
+		delay = target_delay;
+		feedback = target_feedback;
+		mix = target_mix;
+		return (int)((input * (256 - (mix >> 16))) >> 8);
+	}
+
+
+	/* 16 bit linear to 8 bit mu-law, as in G.711 */
+	static inline
+	uint8_t encode(int32_t sample)
+	{
+		uint8_t sign = 0;
+		if (sample < 0){
+			sign = 0x80;
+			sample = -sample;
+		}
+		if (sample > 32635) sample = 32635;
+		sample += 0x84;
+		const uint8_t exponent = (uint8_t)(7 - (__builtin_clz((uint32_t)sample) - 17)); // highest set bit of 14 to 7
+		const uint8_t mantissa = (sample >> (exponent + 3)) & 0x0f;
+		return ~(sign | (exponent << 4) | mantissa);
+	}
+
+
+	/* 8 bit mu-law to 16 bit linear */
+	static inline
+	int16_t decode(uint8_t cell)
+	{
+		cell = ~cell;
+		const uint8_t exponent = (cell >> 4) & 0x07;
+		const int16_t magnitude = (int16_t)((((cell & 0x0f) << 3) + 0x84) << exponent) - 0x84;
+		return (cell & 0x80) ? -magnitude : magnitude;
+	}
+
+
+	inline
+	int tick(int input)
+	{
+		// the glide is limited to half a cell per sample, so the repeats bend between half and
+		// one and a half times their pitch and never play backwards
+		delay += constrain((target_delay - delay) >> SMOOTH_SHIFT, -MAX_GLIDE, MAX_GLIDE);
+		feedback += (target_feedback - feedback) >> SMOOTH_SHIFT;
+		mix += (target_mix - mix) >> SMOOTH_SHIFT;
+
+		++write_pos &= (NUM_BUFFER_SAMPLES - 1);
+
+		// linear interpolation between the two cells around the fractional delay
+		const uint16_t index = (uint16_t)(delay >> 16);
+		const int32_t fraction = (uint16_t)delay >> 1; // Q0n15
+		const int32_t sig1 = decode(delay_array[(write_pos - index) & (NUM_BUFFER_SAMPLES - 1)]);
+		const int32_t sig2 = decode(delay_array[(write_pos - index - 1) & (NUM_BUFFER_SAMPLES - 1)]);
+		const int32_t delay_sig = sig1 + (((sig2 - sig1) * fraction) >> 15);
+
+		lowpass += ((delay_sig - lowpass) * damping) >> 15;
+
+		const int32_t feedback_sig = (lowpass * (feedback >> 16)) >> 8;
+		delay_array[write_pos] = encode(input + feedback_sig); // encode() clips
+
+		const int32_t wet = mix >> 16;
+		return (int)((input * (256 - wet) + lowpass * wet) >> 8);
+	}
+};
+
+#endif        //  #ifndef PT2399ECHO_H_
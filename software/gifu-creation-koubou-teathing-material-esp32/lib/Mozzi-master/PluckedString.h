@@ -0,0 +1,180 @@
+/*
+ * PluckedString.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef PLUCKEDSTRING_H_
+#define PLUCKEDSTRING_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "mozzi_fixmath.h"
+#include "mozzi_rand.h"
+
+/** A Karplus-Strong plucked string.
+
+A delay line as long as one period of the note recirculates through a two point average
+(the loss filter, which makes the high harmonics die away first) and a decay gain.
+pluck() feeds one period of noise from xorshift96() into the loop, and the string rings
+from there.
+
+The two point average delays the loop by half a sample, and the rest of the period is an
+integer number of cells plus a fraction, which is made with a first order allpass so the pitch
+is accurate without the damping that linear interpolation would add to high notes.
+
+Each string costs one buffer read and write, the average, the allpass (one multiply) and the
+decay (one multiply) per sample, so many of them can run together.
+
+@tparam NUM_BUFFER_SAMPLES the length of the delay buffer in samples, a power of two.  The lowest
+note is AUDIO_RATE / NUM_BUFFER_SAMPLES, so 32Hz for 1024 cells (2k of RAM) at 32768Hz.
+*/
+template <uint16_t NUM_BUFFER_SAMPLES = 1024>
+class PluckedString
+{
+
+public:
+	/** Constructor.
+	*/
+	PluckedString(): write_pos(0), delay_cells(100), allpass_coeff(0), decay(65535),
+		last_sig(0), allpass_in(0), allpass_out(0), burst_remaining(0), burst_amplitude(0)
+	{
+		memset(delay_array, 0, sizeof(delay_array));
+		setDecay(240);
+	}
+
+
+	/** Set the pitch.  It takes effect straight away, so it can be changed while the string rings.
+	@param freq the frequency in Hz, from AUDIO_RATE / NUM_BUFFER_SAMPLES to AUDIO_RATE / 4.
+	*/
+	inline
+	void setFreq(float freq)
+	{
+		setFreq_Q16n16(float_to_Q16n16(freq));
+	}
+
+
+	/** Set the pitch with a fixed point frequency.
+	@param freq the frequency in Hz, in Q16n16 fixed point.
+	*/
+	void setFreq_Q16n16(Q16n16 freq)
+	{
+		if (freq == 0) return;
+		// the loop delay is one period, minus half a sample for the average
+		uint64_t period = ((uint64_t)AUDIO_RATE << 32) / freq; // Q16n16 samples
+		if (period > ((uint64_t)(NUM_BUFFER_SAMPLES - 1) << 16)) period = (uint64_t)(NUM_BUFFER_SAMPLES - 1) << 16;
+		if (period < ((uint64_t)4 << 16)) period = (uint64_t)4 << 16;
+		const uint32_t loop_delay = (uint32_t)period - (Q16n16_FIX1 >> 1);
+
+		// keep the allpass delay between 0.1 and 1.1 samples, where its phase delay is flattest
+		delay_cells = (loop_delay - (Q16n16_FIX1 / 10)) >> 16;
+		const uint32_t d = loop_delay - ((uint32_t)delay_cells << 16); // Q16n16, 0.1 to 1.1
+
+		// allpass coefficient (1 - d) / (1 + d), Q1n15
+		allpass_coeff = (int16_t)((((int32_t)Q16n16_FIX1 - (int32_t)d) << 15) / (int32_t)(Q16n16_FIX1 + d));
+	}
+
+
+	/** Set how long the string rings.
+	@param decay_level from 0 (short, like a muted string) to 255 (as long as the loss filter allows).
+	*/
+	inline
+	void setDecay(uint8_t decay_level)
+	{
+		// gain per trip round the loop
+		decay = 65535 - ((uint16_t)(255 - decay_level) << 4);
+	}
+
+
+	/** Pluck the string with one period of noise.  The noise is added to the ringing string, if any.
+	@param amplitude from 0 to 255.
+	*/
+	inline
+	void pluck(uint8_t amplitude = 255)
+	{
+		burst_amplitude = amplitude;
+		burst_remaining = delay_cells + 1;
+	}
+
+
+	/** Stop the string straight away.
+	*/
+	inline
+	void mute()
+	{
+		memset(delay_array, 0, sizeof(delay_array));
+		last_sig = allpass_in = allpass_out = 0;
+		burst_remaining = 0;
+	}
+
+
+	/** Calculate the next sample.
+	@return the signal output, up to about 15 bits.
+	*/
+	inline
+	int next()
+	{
+		++write_pos &= (NUM_BUFFER_SAMPLES - 1);
+		return tick(write_pos);
+	}
+
+
+	/** Calculate a block of samples.
+	@param out receives the signal output, n samples.
+	@param n the number of samples.
+	*/
+	void process(int16_t * out, unsigned int n)
+	{
+		uint16_t w = write_pos;
+		for (unsigned int i = 0; i < n; ++i){
+			++w &= (NUM_BUFFER_SAMPLES - 1);
+			out[i] = (int16_t) tick(w);
+		}
+		write_pos = w;
+	}
+
+
+private:
+	int16_t delay_array[NUM_BUFFER_SAMPLES];
+	uint16_t write_pos;
+	uint16_t delay_cells;
+	int16_t allpass_coeff; // Q1n15
+	uint16_t decay;        // Q0n16
+	int32_t last_sig;
+	int32_t allpass_in, allpass_out;
+	uint16_t burst_remaining;
+	uint8_t burst_amplitude;
+
+
+	inline
+	int tick(uint16_t w)
+	{
+		const int32_t delay_sig = delay_array[(w - delay_cells) & (NUM_BUFFER_SAMPLES - 1)];
+
+		// loss filter, two point average
+		const int32_t average = (delay_sig + last_sig) >> 1;
+		last_sig = delay_sig;
+
+		// fractional delay, first order allpass
+		allpass_out = ((allpass_coeff * (average - allpass_out)) >> 15) + allpass_in;
+		allpass_in = average;
+
+		int32_t sig = (allpass_out * (decay >> 1)) >> 15;
+		if (burst_remaining){
+			--burst_remaining;
+			sig += ((int32_t)(int16_t)(xorshift96() >> 16) * burst_amplitude) >> 9; // up to half of full scale
+		}
+		sig = constrain(sig, -32768, 32767);
+		delay_array[w] = (int16_t) sig;
+		return (int) sig;
+	}
+};
+
+#endif        //  #ifndef PLUCKEDSTRING_H_
@@ -0,0 +1,190 @@
+/*
+ * ResampledSample.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef RESAMPLEDSAMPLE_H_
+#define RESAMPLEDSAMPLE_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+#include "tables/sinc256_int16.h"
+
+/** Plays a sound table recorded at another sample rate, converting it to AUDIO_RATE as it goes.
+
+The sounds in samples/ each have a _SAMPLERATE, and Sample plays them one cell per sample,
+so they only sound right at that rate.  ResampledSample steps through the table by
+source_rate / AUDIO_RATE (times setSpeed()) in Q16n16, and works out each output sample with a
+polyphase windowed sinc filter read from SINC256_DATA, so the same sounds can be used in a 16384
+or a 32768 Hz build.  Going up in rate, 8 input samples go into each output sample.  Going down
+(a step of more than 1), the filter is stretched so its cutoff follows the new Nyquist frequency,
+and it takes 8 times the step, up to a step of 4.
+
+For sounds which are always played at one rate it is cheaper to convert them once with
+extras/python/resample_rate.py, which bakes a new header at the target rate.
+
+@tparam NUM_TABLE_CELLS the length of the sound table, which can be any length up to 65535.
+*/
+template <unsigned int NUM_TABLE_CELLS>
+class ResampledSample
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of the array with the sound.
+	@param source_rate the rate the sound was recorded at, for example BAMBOO_00_2048_SAMPLERATE.
+	*/
+	ResampledSample(const int8_t * TABLE_NAME, unsigned int source_rate): table(TABLE_NAME),
+		phase_fractional((unsigned long)NUM_TABLE_CELLS << 16), speed(Q16n16_FIX1)
+	{
+		setSourceRate(source_rate);
+	}
+
+
+	/** Set the rate the table was recorded at.
+	@param source_rate in Hz.
+	*/
+	inline
+	void setSourceRate(unsigned int source_rate)
+	{
+		rate_step = ((uint32_t)source_rate << 16) / AUDIO_RATE;
+		updateStep();
+	}
+
+
+	/** Set the playback speed on top of the rate conversion.
+	@param playback_speed in Q16n16, so Q16n16_FIX1 plays at the recorded pitch.
+	*/
+	inline
+	void setSpeed(Q16n16 playback_speed)
+	{
+		speed = playback_speed;
+		updateStep();
+	}
+
+
+	/** Play from the start of the table, or from a position in it.
+	@param startpos the cell to start from.
+	*/
+	inline
+	void start(unsigned int startpos = 0)
+	{
+		phase_fractional = (unsigned long)startpos << 16;
+	}
+
+
+	/** Tells if the sound is still playing.
+	*/
+	inline
+	bool isPlaying()
+	{
+		return phase_fractional < ((unsigned long)NUM_TABLE_CELLS << 16);
+	}
+
+
+	/** Calculate the next sample.
+	@return the sound, 16 bits: the 8 bit table values shifted up by 8, 0 when it has finished.
+	*/
+	inline
+	int next()
+	{
+		int16_t out;
+		render(&out, 1);
+		return out;
+	}
+
+
+	/** Fill a block with the next n samples.
+	@param out receives n samples, 16 bits, 0 after the sound has finished.
+	@param n the number of samples.
+	*/
+	void render(int16_t * out, unsigned int n)
+	{
+		const unsigned long end = (unsigned long)NUM_TABLE_CELLS << 16;
+		unsigned long phase = phase_fractional;
+		unsigned int i = 0;
+		for (; i < n && phase < end; ++i){
+			out[i] = interpolate(phase);
+			phase += step;
+		}
+		for (; i < n; ++i) out[i] = 0;
+		phase_fractional = phase;
+	}
+
+
+private:
+	static const uint8_t HALF_WIDTH = 4;   // the kernel covers 4 input samples either side
+	static const uint8_t CELL_SHIFT = 18;  // 64 kernel cells to an input sample, in Q8n24
+	static const uint32_t MAX_STEP = (uint32_t)4 << 16;
+
+	const int8_t * table;
+	unsigned long phase_fractional; // Q16n16 cells
+	uint32_t rate_step, speed, step; // Q16n16
+	uint32_t kernel_scale;          // Q0n16, 1 until the step is more than 1
+	int16_t reach;                  // how many input samples either side go into an output sample
+
+
+	void updateStep()
+	{
+		step = (uint32_t)(((uint64_t)rate_step * speed) >> 16);
+		if (step > MAX_STEP) step = MAX_STEP;
+		if (step > Q16n16_FIX1) {
+			kernel_scale = (uint32_t)(((uint64_t)1 << 32) / step);
+			reach = (int16_t)(((uint32_t)HALF_WIDTH * step + 0xffff) >> 16);
+		} else {
+			kernel_scale = Q16n16_FIX1;
+			reach = HALF_WIDTH;
+		}
+	}
+
+
+	/* the windowed sinc at a distance from the centre, in Q12n12 input samples */
+	static inline
+	int32_t kernel(uint32_t distance)
+	{
+		const uint32_t position = distance << 12; // Q8n24
+		const uint32_t index = position >> CELL_SHIFT;
+		if (index >= SINC256_NUM_CELLS) return 0;
+		const int32_t fraction = (position >> (CELL_SHIFT - 15)) & 0x7fff;
+		const int32_t a = FLASH_OR_RAM_READ<const int16_t>(SINC256_DATA + index);
+		const int32_t b = FLASH_OR_RAM_READ<const int16_t>(SINC256_DATA + index + 1);
+		return a + (((b - a) * fraction) >> 15);
+	}
+
+
+	inline
+	int16_t interpolate(unsigned long phase)
+	{
+		const int32_t centre = phase >> 16;
+		const int32_t fraction = phase & 0xffff;
+		int32_t first = centre - reach + 1;
+		int32_t last = centre + reach;
+		if (first < 0) first = 0;
+		if (last > (int32_t)NUM_TABLE_CELLS - 1) last = NUM_TABLE_CELLS - 1;
+
+		// the distance of each tap from the playback position, scaled to the kernel, Q12n12
+		int32_t distance = ((first - centre) << 12) - (fraction >> 4);
+		const int32_t scale = kernel_scale >> 4;
+		int32_t sum = 0;
+		for (int32_t k = first; k <= last; ++k){
+			const uint32_t d = (uint32_t)(((distance < 0) ? -distance : distance) * scale) >> 12;
+			sum += FLASH_OR_RAM_READ<const int8_t>(table + k) * kernel(d);
+			distance += 1 << 12;
+		}
+		// the kernel is Q0n15 and the output is 8 bits shifted up by 8; stretched kernels are scaled down
+		const int32_t y = (int32_t)(((int64_t)sum * kernel_scale) >> 23);
+		return (int16_t)constrain(y, -32768, 32767);
+	}
+};
+
+#endif        //  #ifndef RESAMPLEDSAMPLE_H_
@@ -0,0 +1,217 @@
+#ifndef REVERBFDN_H
+#define REVERBFDN_H
+
+/*
+ * ReverbFDN.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "SilenceDetector.h"
+
+/**
+A feedback delay network reverb, for a denser tail than ReverbTank.
+NUM_LINES delay lines with lengths of different primes, so no two share a factor, are read, mixed with a Hadamard
+matrix (a fast Walsh-Hadamard transform, so only additions), damped with a
+one-pole lowpass, scaled by the feedback level and written back with the input.
+
+The Hadamard matrix is scaled by 1/sqrt(NUM_LINES) to be lossless, and that
+scaling is folded into the feedback gain, so there is one multiply per line per sample.
+
+Like ReverbTank, this returns only the "wet" signal.  Use process() for blocks:
+the write position stays in a local for the whole block.
+
+When the input and the tail have been within the silence threshold for the length of a delay
+buffer, the reverb stops working and returns 0 until input comes again, see isSilent().
+
+Memory is NUM_LINES * LINE_CELLS * 2 bytes, 4k for the defaults.
+@tparam NUM_LINES the number of delay lines, 4 or 8.
+@tparam LINE_CELLS the length of each delay buffer in samples, a power of two, 32 or more.
+The delay line lengths are the primes nearest to fractions of this, from about 1/3 to all of it.
+*/
+template <uint8_t NUM_LINES = 4, uint16_t LINE_CELLS = 512>
+class ReverbFDN {
+
+	static_assert(NUM_LINES == 4 || NUM_LINES == 8, "ReverbFDN supports 4 or 8 lines");
+	static_assert((LINE_CELLS & (LINE_CELLS - 1)) == 0, "LINE_CELLS must be a power of two");
+	static_assert(LINE_CELLS >= 32, "LINE_CELLS must be at least 32, to have a prime length for each line");
+
+public:
+	/** Constructor.
+	@param feedback_level how long the tail is, from 0 to 255 (255 is close to infinite)
+	@param damping how much the high frequencies are damped in the tail, from 0 (none) to 255
+	*/
+	ReverbFDN(uint8_t feedback_level = 200, uint8_t damping = 64): _write_pos(0), _silence(LINE_CELLS, 4)
+	{
+		// fractions of the buffer, spread between 1/3 and 1, each moved to the nearest prime
+		// not taken by an earlier line, so the echoes of the lines do not line up
+		static const uint16_t primes_per_mille[8] = {331, 419, 503, 613, 709, 797, 887, 997};
+		for (uint8_t i = 0; i < NUM_LINES; ++i){
+			const uint8_t spread = (NUM_LINES == 4) ? (i * 2 + 1) : i;
+			const uint16_t target = (uint16_t)(((uint32_t)(LINE_CELLS - 1) * primes_per_mille[spread]) / 1000);
+			_lengths[i] = target;
+			for (uint16_t d = 0; d < LINE_CELLS; ++d){
+				if (target >= d && isFreePrime(target - d, i)) {
+					_lengths[i] = target - d;
+					break;
+				}
+				if (target + d < LINE_CELLS && isFreePrime(target + d, i)) {
+					_lengths[i] = target + d;
+					break;
+				}
+			}
+		}
+		clear();
+		setFeedbackLevel(feedback_level);
+		setDamping(damping);
+	}
+
+
+	/** Set the length of the tail.
+	@param feedback_level from 0 to 255 (255 is close to infinite)
+	*/
+	void setFeedbackLevel(uint8_t feedback_level){
+		// 1/sqrt(4) = 0.5 and 1/sqrt(8) = 0.354 in Q0n16
+		const uint32_t hadamard_scale = (NUM_LINES == 4) ? 32768 : 23170;
+		_gain = (int16_t)(((uint32_t)feedback_level * hadamard_scale) >> 11); // Q0n13, keeps x * _gain inside 32 bits
+	}
+
+
+	/** Set the damping of the high frequencies in the tail.
+	@param damping from 0 (none) to 255
+	*/
+	void setDamping(uint8_t damping){
+		_damping = damping;
+	}
+
+
+	/** Process the next audio sample and return the reverbed signal.
+	@param input the audio signal to process, up to 15 bits
+	@return the processed signal
+	*/
+	int next(int input){
+		if (_silence.isSilent()) {
+			if (_silence.isQuiet(input)) return 0;
+			clear();
+		}
+		const int out = tick(input, ++_write_pos);
+		_silence.update(_silence.isQuiet(input) && _silence.isQuiet(out));
+		return out;
+	}
+
+
+	/** Process a block of audio.
+	@param in the audio signal to process, n samples
+	@param out receives the processed signal, n samples.  It can be the same buffer as in.
+	@param n the number of samples
+	*/
+	void process(const int16_t * in, int16_t * out, unsigned int n){
+		const bool quiet_in = _silence.isQuiet(in, n);
+		if (_silence.isSilent()) {
+			if (quiet_in) {
+				memset(out, 0, n * sizeof(int16_t));
+				return;
+			}
+			clear();
+		}
+		uint16_t write_pos = _write_pos;
+		for (unsigned int i = 0; i < n; ++i){
+			out[i] = (int16_t) tick(in[i], ++write_pos);
+		}
+		_write_pos = write_pos;
+		_silence.update(quiet_in && _silence.isQuiet(out, n), n);
+	}
+
+
+	/** Set how loud the input and tail can be and still count as silence.
+	@param threshold the largest sample either way from 0, 4 by default.  0 waits for exact silence.
+	*/
+	void setSilenceThreshold(int threshold){
+		_silence.setThreshold(threshold);
+	}
+
+
+	/** Tells if the reverb is asleep: the input and tail have been quiet for the length of a
+	delay buffer, and next() and process() return silence without running the delay lines.
+	*/
+	bool isSilent() const {
+		return _silence.isSilent();
+	}
+
+
+private:
+	int16_t _lines[NUM_LINES][LINE_CELLS];
+	uint16_t _lengths[NUM_LINES];
+	int32_t _lowpass[NUM_LINES]; // fed back signal, up to about twice full scale when the lines are all near it
+	uint16_t _write_pos;
+	int16_t _gain;
+	uint8_t _damping;
+	SilenceDetector _silence;
+
+	// a prime which none of the first num_set lines has
+	bool isFreePrime(uint16_t n, uint8_t num_set) const {
+		if (n < 2) return false;
+		for (uint16_t f = 2; (uint32_t)f * f <= n; ++f){
+			if (n % f == 0) return false;
+		}
+		for (uint8_t i = 0; i < num_set; ++i){
+			if (_lengths[i] == n) return false;
+		}
+		return true;
+	}
+
+	// empty delay lines, so a reverb woken from silence does not play back what was left in them
+	void clear(){
+		memset(_lines, 0, sizeof(_lines));
+		memset(_lowpass, 0, sizeof(_lowpass));
+	}
+
+	inline
+	int tick(int input, uint16_t write_pos)
+	{
+		int32_t x[NUM_LINES];
+		int32_t out = 0;
+		for (uint8_t i = 0; i < NUM_LINES; ++i){
+			x[i] = _lines[i][(write_pos - _lengths[i]) & (LINE_CELLS - 1)];
+			out += x[i];
+		}
+
+		// fast Walsh-Hadamard transform
+		for (uint8_t h = 1; h < NUM_LINES; h <<= 1){
+			for (uint8_t i = 0; i < NUM_LINES; i += h << 1){
+				for (uint8_t j = i; j < i + h; ++j){
+					const int32_t a = x[j];
+					const int32_t b = x[j + h];
+					x[j] = a + b;
+					x[j + h] = a - b;
+				}
+			}
+		}
+
+		const uint16_t write_index = write_pos & (LINE_CELLS - 1);
+		for (uint8_t i = 0; i < NUM_LINES; ++i){
+			const int32_t fed_back = (x[i] * _gain + 4096) >> 13; // rounded, so the tail does not settle on a dc offset
+			_lowpass[i] += ((fed_back - _lowpass[i]) * (256 - _damping) + 128) >> 8;
+			const int32_t sig = input + _lowpass[i];
+			_lines[i][write_index] = (int16_t) min(max(sig, (int32_t)-32768), (int32_t)32767); // clipped
+		}
+
+		return (int)(out >> ((NUM_LINES == 4) ? 2 : 3));
+	}
+};
+
+/**
+@example 09.Delays/ReverbTank_STANDARD/ReverbTank_STANDARD.ino
+ReverbFDN can be swapped in for ReverbTank in this example.
+*/
+
+#endif        //  #ifndef REVERBFDN_H
@@ -12,7 +12,14 @@
  *
  */
 
-#include "AudioDelay.h"
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "SilenceDetector.h"
+
 /**
 A reverb which sounds like the inside of a tin can.
 ReverbTank is small enough to fit on the Arduino Nano, which for some reason
@@ -28,6 +35,11 @@ The room size according to the maximum delay lengths corresponds to:
 early reflections and recirculating delay 1: 128/16384 seconds * 340.29 m/s speed of sound = 3.5 metres
 recirculating delay 2: 7 metres
 It looks bigger on paper than it sounds.
+
+Each instance keeps its own feedback state, so several ReverbTanks can run side by side.
+Besides next(), there is a block version, process(), which keeps the write position
+and the feedback state in locals for the whole block. For a denser tail, see ReverbFDN.
+Once the input and the tail have gone quiet, it stops working until input comes again, see isSilent().
 */
 class
 	ReverbTank {
@@ -49,11 +61,13 @@ public:
 	  int8_t loop1_delay=117,
 	  uint8_t loop2_delay=255,
 	  int8_t feedback_level = 85):
-			_early_reflection1(early_reflection1),_early_reflection2(early_reflection3),_early_reflection3(early_reflection3),
-			_feedback_level(feedback_level)
+			_early_reflection1(early_reflection1),_early_reflection2(early_reflection2),_early_reflection3(early_reflection3),
+			_feedback_level(feedback_level),
+			_loop1_delay(loop1_delay), _loop2_delay(loop2_delay),
+			_write_pos(0), _recycle1(0), _recycle2(0),
+			_silence(EARLY_CELLS + LOOP2_CELLS)
 	{
-		aLoopDel1.set(loop1_delay);
-		aLoopDel2.set(loop2_delay);
+		clear();
 	}
 
 
@@ -63,23 +77,41 @@ public:
 	@return the processed signal
 	*/
 	int next(int input){
-		static int recycle1, recycle2;
-
-		// early reflections
-		int asig = aLoopDel0.next(input, _early_reflection1);
-		asig += aLoopDel0.read(_early_reflection2);
-		asig += aLoopDel0.read(_early_reflection3);
-		asig >>= 2;
+		if (_silence.isSilent()) {
+			if (_silence.isQuiet(input)) return 0;
+			clear();
+		}
+		const int out = tick(input, ++_write_pos, _recycle1, _recycle2);
+		_silence.update(_silence.isQuiet(input) && _silence.isQuiet(out));
+		return out;
+	}
 
-		// recirculating delays
-		int8_t feedback_sig1 = (int8_t) min(max(((recycle1 * _feedback_level)>>7),-128),127); // feedback clipped
-		int8_t feedback_sig2 = (int8_t) min(max(((recycle2 * _feedback_level)>>7),-128),127); // feedback clipped
-		int sig3 = aLoopDel1.next(asig+feedback_sig1);
-		int sig4 = aLoopDel2.next(asig+feedback_sig2);
-		recycle1 = sig3 + sig4;
-		recycle2 = sig3 - sig4;
 
-		return recycle1;
+	/** Process a block of audio.  Like next(), this returns only the "wet" signal.
+	The write position and feedback state stay in locals for the whole block.
+	@param in the audio signal to process, n samples
+	@param out receives the processed signal, n samples.  It can be the same buffer as in.
+	@param n the number of samples
+	*/
+	void process(const int16_t * in, int16_t * out, unsigned int n){
+		const bool quiet_in = _silence.isQuiet(in, n);
+		if (_silence.isSilent()) {
+			if (quiet_in) {
+				memset(out, 0, n * sizeof(int16_t));
+				return;
+			}
+			clear();
+		}
+		uint16_t write_pos = _write_pos;
+		int recycle1 = _recycle1;
+		int recycle2 = _recycle2;
+		for (unsigned int i = 0; i < n; ++i){
+			out[i] = (int16_t) tick(in[i], ++write_pos, recycle1, recycle2);
+		}
+		_write_pos = write_pos;
+		_recycle1 = recycle1;
+		_recycle2 = recycle2;
+		_silence.update(quiet_in && _silence.isQuiet(out, n), n);
 	}
 
 
@@ -100,8 +132,8 @@ public:
 	@param loop2_delay how long in delay cells for the first recirculating delay, form 0 to 255
 	*/
 	void setLoopDelays(int8_t loop1_delay, uint8_t loop2_delay){
-		aLoopDel1.set(loop1_delay);
-		aLoopDel2.set(loop2_delay);
+		_loop1_delay = loop1_delay;
+		_loop2_delay = loop2_delay;
 	}
 
 	/** Set the feedback level for the recirculating delays.
@@ -112,16 +144,80 @@ public:
 	}
 
 
+	/** Set how loud the input and tail can be and still count as silence.
+	@param threshold the largest sample either way from 0, 0 by default, as the tail dies away to exact silence.
+	*/
+	void setSilenceThreshold(int threshold){
+		_silence.setThreshold(threshold);
+	}
+
+
+	/** Tells if the reverb is asleep: the input and tail have been quiet for the length of the
+	delays, and next() and process() return silence without running them.
+	*/
+	bool isSilent() const {
+		return _silence.isSilent();
+	}
+
+
 private:
+	static const uint16_t EARLY_CELLS = 128; // 128/16384 seconds * 340.29 m/s speed of sound = 3.5 metres
+	static const uint16_t LOOP1_CELLS = 128;
+	static const uint16_t LOOP2_CELLS = 256; // 7 metres
+
 	int8_t _early_reflection1;
 	int8_t _early_reflection2;
 	int8_t _early_reflection3;
 
 	int8_t _feedback_level;
+	int8_t _loop1_delay;
+	uint8_t _loop2_delay;
+
+	// the three delay lines advance together, so they share one write position
+	uint16_t _write_pos;
+	int _recycle1, _recycle2;
+
+	int8_t _early_array[EARLY_CELLS];
+	int _loop1_array[LOOP1_CELLS];
+	int _loop2_array[LOOP2_CELLS];
+
+	SilenceDetector _silence;
+
+	// empty delays, so a reverb woken from silence does not play back what was left in them
+	void clear(){
+		memset(_early_array, 0, sizeof(_early_array));
+		memset(_loop1_array, 0, sizeof(_loop1_array));
+		memset(_loop2_array, 0, sizeof(_loop2_array));
+		_recycle1 = _recycle2 = 0;
+	}
+
+	// one sample, with the write position and feedback state passed in
+	inline
+	int tick(int input, uint16_t write_pos, int & recycle1, int & recycle2)
+	{
+		const uint16_t early_write = write_pos & (EARLY_CELLS - 1);
+		const uint16_t loop1_write = write_pos & (LOOP1_CELLS - 1);
+		const uint16_t loop2_write = write_pos & (LOOP2_CELLS - 1);
 
-	AudioDelay <128> aLoopDel0; // 128/16384 seconds * 340.29 m/s speed of sound = 3.5 metres
-	AudioDelay <128,int> aLoopDel1;
-	AudioDelay <256,int> aLoopDel2; // 7 metres
+		// early reflections
+		_early_array[early_write] = (int8_t) input;
+		int asig = _early_array[(write_pos - _early_reflection1) & (EARLY_CELLS - 1)];
+		asig += _early_array[(write_pos - _early_reflection2) & (EARLY_CELLS - 1)];
+		asig += _early_array[(write_pos - _early_reflection3) & (EARLY_CELLS - 1)];
+		asig >>= 2;
+
+		// recirculating delays
+		int8_t feedback_sig1 = (int8_t) min(max(((recycle1 * _feedback_level)/128),-128),127); // feedback clipped, and rounded towards 0 so the tail dies away
+		int8_t feedback_sig2 = (int8_t) min(max(((recycle2 * _feedback_level)/128),-128),127); // feedback clipped, and rounded towards 0 so the tail dies away
+		_loop1_array[loop1_write] = asig + feedback_sig1;
+		_loop2_array[loop2_write] = asig + feedback_sig2;
+		int sig3 = _loop1_array[(write_pos - _loop1_delay) & (LOOP1_CELLS - 1)];
+		int sig4 = _loop2_array[(write_pos - _loop2_delay) & (LOOP2_CELLS - 1)];
+		recycle1 = sig3 + sig4;
+		recycle2 = sig3 - sig4;
+
+		return recycle1;
+	}
 
 };
 
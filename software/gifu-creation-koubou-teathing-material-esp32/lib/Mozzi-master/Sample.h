@@ -24,12 +24,16 @@
 // the fractional part and the sign bit
 #define SAMPLE_PHMOD_BITS 16
 
-enum interpolation {INTERP_NONE, INTERP_LINEAR};
+enum interpolation {INTERP_NONE, INTERP_LINEAR, INTERP_HERMITE};
 
 /** Sample is like Oscil, it plays a wavetable.  However, Sample can be
 set to play once through only, with variable start and end points,
 or can loop, also with variable start and end points.
 It defaults to playing once through the whole sound table, from start to finish.
+
+Besides next(), render() and mix() play a block at a time.  They work out how many samples are
+left before the end (or the loop point) once for each block, instead of checking on every sample,
+so they are cheaper when many Samples play at once, for example a set of drum hits.
 @tparam NUM_TABLE_CELLS This is defined in the table ".h" file the Sample will be
 using.  The sound table can be arbitrary length for Sample.
 It's important that NUM_TABLE_CELLS is either a literal number (eg. "8192") or a
@@ -38,6 +42,9 @@ defined macro, rather than a const or int, for the Sample to run fast enough.
 updateAudio(), or CONTROL_RATE if it's updated each time updateControl() is
 called. It could also be a fraction of CONTROL_RATE if you are doing some kind
 of cyclic updating in updateControl(), for example, to spread out the processor load.
+@tparam INTERP INTERP_NONE, INTERP_LINEAR, or INTERP_HERMITE for 4 point (Catmull-Rom)
+interpolation, which has less of the imaging and dulling of linear interpolation when the
+sample is pitched up or down by several octaves.
 @section int8_t2mozzi
 Converting soundfiles for Mozzi.
 There is a python script called int8_t2mozzi.py in the Mozzi/python folder.
@@ -56,7 +63,7 @@ public:
 	Mozzi by the int8_t2mozzi.py python script in Mozzi's python
 	folder.  Sound tables can be of arbitrary lengths for Sample().
 	*/
-	Sample(const int8_t * TABLE_NAME):table(TABLE_NAME),endpos_fractional((unsigned long) NUM_TABLE_CELLS << SAMPLE_F_BITS) // so isPlaying() will work
+	Sample(const int8_t * TABLE_NAME):table(TABLE_NAME),startpos_fractional(0),endpos_fractional((unsigned long) NUM_TABLE_CELLS << SAMPLE_F_BITS) // so isPlaying() will work
 	{
 		setLoopingOff();
 		//rangeWholeSample();
@@ -68,7 +75,7 @@ public:
 	Declare a Sample with template TABLE_NUM_CELLS and UPDATE_RATE parameters, without specifying a particular wave table for it to play.
 	The table can be set or changed on the fly with setTable().
 	*/
-	Sample():endpos_fractional((unsigned long) NUM_TABLE_CELLS << SAMPLE_F_BITS)
+	Sample():startpos_fractional(0),endpos_fractional((unsigned long) NUM_TABLE_CELLS << SAMPLE_F_BITS)
 	{
 		setLoopingOff();
 		//rangeWholeSample();
@@ -165,28 +172,39 @@ public:
 	int8_t next() { // 4us
 
 		if (phase_fractional>endpos_fractional){
-			if (looping) {
-				phase_fractional = startpos_fractional + (phase_fractional - endpos_fractional);
+			if (looping && endpos_fractional > startpos_fractional) {
+				phase_fractional = loopPhase(phase_fractional);
 			}else{
 				return 0;
 			}
 		}
-		int8_t out;
-		if(INTERP==INTERP_LINEAR){
-			// WARNNG this is hard coded for when SAMPLE_F_BITS is 16
-			unsigned int index = phase_fractional >> SAMPLE_F_BITS;
-			out = FLASH_OR_RAM_READ<const int8_t>(table + index);
-			int8_t difference = FLASH_OR_RAM_READ<const int8_t>((table + 1) + index) - out;
-			int8_t diff_fraction = (int8_t)(((((unsigned int) phase_fractional)>>8)*difference)>>8); // (unsigned int) phase_fractional keeps low word, then>> for only 8 bit precision
-			out += diff_fraction;
-		}else{
-			out = FLASH_OR_RAM_READ<const int8_t>(table + (phase_fractional >> SAMPLE_F_BITS));
-		}
+		const int8_t out = (int8_t)read<true>(phase_fractional);
 		incrementPhase();
 		return out;
 	}
 
 
+	/** Fill a block with the next n samples, the same as calling next() n times.
+	When the sample finishes, the rest of the block is filled with 0.
+	@param out receives n samples, in the range of next().
+	@param n the number of samples.
+	*/
+	void render(int16_t * out, unsigned int n)
+	{
+		renderBlock<false>(out, n);
+	}
+
+
+	/** Add the next n samples into a block, for mixing several Samples together.
+	@param out n samples, which the Sample is added to.
+	@param n the number of samples.
+	*/
+	void mix(int16_t * out, unsigned int n)
+	{
+		renderBlock<true>(out, n);
+	}
+
+
 	/** Checks if the sample is playing by seeing if the phase is within the limits of its end position.
 	@return true if the sample is playing
 	*/
@@ -311,6 +329,117 @@ static const uint8_t ADJUST_FOR_NUM_TABLE_CELLS = (NUM_TABLE_CELLS<2048) ? 8 : 0
 	}
 
 
+	/* back into the loop after the phase has gone past the end, by as far as it went past */
+	inline
+	unsigned long loopPhase(unsigned long phase)
+	{
+		return startpos_fractional + ((phase - endpos_fractional) % (endpos_fractional - startpos_fractional));
+	}
+
+
+	/* the sample at a phase, with the cells outside the table read as 0 when GUARDED */
+	template <bool GUARDED>
+	inline
+	int8_t readCell(long index)
+	{
+		if (GUARDED && (index < 0 || index >= (long)NUM_TABLE_CELLS)) return 0;
+		return FLASH_OR_RAM_READ<const int8_t>(table + index);
+	}
+
+
+	template <bool GUARDED>
+	inline
+	int read(unsigned long phase)
+	{
+		const long index = phase >> SAMPLE_F_BITS;
+		if (INTERP == INTERP_HERMITE) return readHermite<GUARDED>(phase);
+		const int x0 = readCell<GUARDED>(index);
+		if (INTERP == INTERP_LINEAR) {
+			const int x1 = readCell<GUARDED>(index + 1);
+			return x0 + (((x1 - x0) * (int)((phase >> 8) & 0xff)) >> 8);
+		}
+		return x0;
+	}
+
+
+	/* Catmull-Rom interpolation between the cells either side of the phase.  The terms are
+	doubled to keep them whole, and scaled by 16 to keep some of the fraction through the sums. */
+	template <bool GUARDED>
+	inline
+	int readHermite(unsigned long phase)
+	{
+		const long index = phase >> SAMPLE_F_BITS;
+		const int32_t xm1 = readCell<GUARDED>(index - 1);
+		const int32_t x0 = readCell<GUARDED>(index);
+		const int32_t x1 = readCell<GUARDED>(index + 1);
+		const int32_t x2 = readCell<GUARDED>(index + 2);
+		const int32_t t = (phase >> 4) & 0xfff; // Q0n12
+		const int32_t c1 = (x1 - xm1) << 4;
+		const int32_t c2 = (2 * xm1 - 5 * x0 + 4 * x1 - x2) << 4;
+		const int32_t c3 = ((x2 - xm1) + 3 * (x0 - x1)) << 4;
+		int32_t y = ((c3 * t) >> 12) + c2;
+		y = ((y * t) >> 12) + c1;
+		y = ((y * t) >> 12) + (x0 << 5);
+		return constrain((y + 16) >> 5, -128, 127);
+	}
+
+
+	/* Plays n samples, in runs which don't need checks on each sample: each run stops at the end
+	of the sample, and where the interpolation starts or stops reaching outside the table. */
+	template <bool ADD>
+	void renderBlock(int16_t * out, unsigned int n)
+	{
+		const unsigned long low_guard = (INTERP == INTERP_HERMITE) ? (1UL << SAMPLE_F_BITS) : 0;
+		const unsigned long high_guard = (unsigned long)(NUM_TABLE_CELLS - ((INTERP == INTERP_HERMITE) ? 2 : (INTERP == INTERP_LINEAR) ? 1 : 0)) << SAMPLE_F_BITS;
+		const unsigned long increment = phase_increment_fractional;
+		unsigned long phase = phase_fractional;
+
+		while (n) {
+			if (phase > endpos_fractional) {
+				if (looping && endpos_fractional > startpos_fractional) {
+					phase = loopPhase(phase);
+				} else {
+					if (!ADD) memset(out, 0, n * sizeof(int16_t));
+					break;
+				}
+			}
+
+			bool guarded = true;
+			unsigned long limit = endpos_fractional + 1; // the end position is played, as in next()
+			if (phase < low_guard) {
+				if (limit > low_guard) limit = low_guard;
+			} else if (phase < high_guard) {
+				guarded = false;
+				if (limit > high_guard) limit = high_guard;
+			}
+
+			// the number of samples before the phase reaches the limit
+			unsigned int count = n;
+			if (increment) {
+				const unsigned long steps = (limit - phase + increment - 1) / increment;
+				if (steps < count) count = steps;
+			}
+
+			if (guarded) {
+				for (unsigned int i = 0; i < count; ++i){
+					const int sample = read<true>(phase);
+					out[i] = ADD ? out[i] + sample : sample;
+					phase += increment;
+				}
+			} else {
+				for (unsigned int i = 0; i < count; ++i){
+					const int sample = read<false>(phase);
+					out[i] = ADD ? out[i] + sample : sample;
+					phase += increment;
+				}
+			}
+			out += count;
+			n -= count;
+		}
+		phase_fractional = phase;
+	}
+
+
 	volatile unsigned long phase_fractional;
 	volatile unsigned long phase_increment_fractional;
 	const int8_t * table;
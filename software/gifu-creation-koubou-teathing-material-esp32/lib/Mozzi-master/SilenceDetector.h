@@ -0,0 +1,111 @@
+/*
+ * SilenceDetector.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef SILENCEDETECTOR_H_
+#define SILENCEDETECTOR_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+/** Keeps track of whether an audio stage with memory, like a delay or a reverb, has gone quiet, so
+it can stop working until there is input again.
+
+The stage passes update() whether the input and output of each sample or block were within the
+threshold.  Once they have been for hold_samples in a row, which should be at least the longest
+delay in the stage so everything still in its buffers has come out, isSilent() is true.  Then the
+stage can return silence without touching its buffers, and when input comes again, clear them and
+start from nothing.  It starts silent, as the buffers of a new stage are empty.
+@code
+void process(const int16_t * in, int16_t * out, unsigned int n){
+	const bool quiet_in = silence.isQuiet(in, n);
+	if (silence.isSilent()) {
+		if (quiet_in) { memset(out, 0, n * sizeof(int16_t)); return; } // asleep
+		clear();                                                        // woken by input
+	}
+	...
+	silence.update(quiet_in && silence.isQuiet(out, n), n);
+}
+@endcode
+*/
+class SilenceDetector
+{
+
+public:
+	/** Constructor.
+	@param hold_samples how long the input and output must stay within the threshold before the stage is silent.
+	@param threshold the largest sample, either way from 0, which counts as quiet.
+	*/
+	SilenceDetector(uint32_t hold_samples, int threshold = 0): hold(hold_samples), quiet_samples(hold_samples), limit(threshold)
+	{}
+
+
+	/** Set the largest sample, either way from 0, which counts as quiet.
+	@param threshold 0 for only exact silence.
+	*/
+	inline
+	void setThreshold(int threshold)
+	{
+		limit = threshold;
+	}
+
+
+	/** Tells if one sample is within the threshold.
+	*/
+	inline
+	bool isQuiet(int sample) const
+	{
+		return (sample <= limit) && (sample >= -limit);
+	}
+
+
+	/** Tells if every sample of a block is within the threshold.
+	*/
+	bool isQuiet(const int16_t * block, unsigned int n) const
+	{
+		for (unsigned int i = 0; i < n; ++i){
+			if (!isQuiet(block[i])) return false;
+		}
+		return true;
+	}
+
+
+	/** Count samples towards silence, or start again if they were not quiet.
+	@param quiet true if the input and output of the samples were all within the threshold.
+	@param n the number of samples.
+	*/
+	inline
+	void update(bool quiet, unsigned int n = 1)
+	{
+		if (!quiet) {
+			quiet_samples = 0;
+		} else if (quiet_samples < hold) {
+			quiet_samples += n;
+		}
+	}
+
+
+	/** Tells if the stage has been quiet long enough to stop working.
+	*/
+	inline
+	bool isSilent() const
+	{
+		return quiet_samples >= hold;
+	}
+
+
+private:
+	uint32_t hold;
+	uint32_t quiet_samples;
+	int limit;
+};
+
+#endif        //  #ifndef SILENCEDETECTOR_H_
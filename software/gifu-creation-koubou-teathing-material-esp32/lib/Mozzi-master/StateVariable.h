@@ -48,6 +48,7 @@ Soc., Vol 45, No. 9, 1997 September
 #include "math.h"
 #include "meta.h"
 #include "mozzi_fixmath.h"
+#include "mozzi_mult.h"
 #include "mozzi_utils.h"
 
 enum filter_types { LOWPASS, BANDPASS, HIGHPASS, NOTCH };
@@ -121,6 +122,12 @@ private:
   Q0n8 q, scale;
   volatile Q15n16 f;
 
+  // f * x >> 16.  Where int is 32 bits the product can need more than 32 bits, so it goes through
+  // a 32 x 32 multiply which keeps the top bits
+  inline int fmul(int x) {
+    return (sizeof(int) == 2) ? (int)((f * x) >> 16) : (int)mult_s32x32_shr<16>(f, x);
+  }
+
   /** Calculate the next sample, given an input signal.
   @param in the signal input.
   @return the signal output.
@@ -128,9 +135,9 @@ private:
   */
   inline int next(int input, Int2Type<LOWPASS>) {
     // setPin13High();
-    low += ((f * band) >> 16);
+    low += fmul(band);
     int high = (((long)input - low - (((long)band * q) >> 8)) * scale) >> 8;
-    band += ((f * high) >> 16);
+    band += fmul(high);
     // int notch = high + low;
     // setPin13Low();
     return low;
@@ -143,9 +150,9 @@ private:
   */
   inline int next(int input, Int2Type<BANDPASS>) {
     // setPin13High();
-    low += ((f * band) >> 16);
+    low += fmul(band);
     int high = (((long)input - low - (((long)band * q) >> 8)) * scale) >> 8;
-    band += ((f * high) >> 16);
+    band += fmul(high);
     // int notch = high + low;
     // setPin13Low();
     return band;
@@ -158,9 +165,9 @@ private:
   */
   inline int next(int input, Int2Type<HIGHPASS>) {
     // setPin13High();
-    low += ((f * band) >> 16);
+    low += fmul(band);
     int high = (((long)input - low - (((long)band * q) >> 8)) * scale) >> 8;
-    band += ((f * high) >> 16);
+    band += fmul(high);
     // int notch = high + low;
     // setPin13Low();
     return high;
@@ -173,9 +180,9 @@ private:
   */
   inline int next(int input, Int2Type<NOTCH>) {
     // setPin13High();
-    low += ((f * band) >> 16);
+    low += fmul(band);
     int high = (((long)input - low - (((long)band * q) >> 8)) * scale) >> 8;
-    band += ((f * high) >> 16);
+    band += fmul(high);
     int notch = high + low;
     // setPin13Low();
     return notch;
@@ -0,0 +1,140 @@
+/*
+ * StateVariableTuned.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons
+ * Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef STATEVARIABLETUNED_H_
+#define STATEVARIABLETUNED_H_
+
+#include "Arduino.h"
+#include "math.h"
+#include "mozzi_fixmath.h"
+#include "mozzi_midi.h"
+#include "mozzi_pgmspace.h"
+#include "StateVariable.h"
+#include "tables/svfcoeff256_uint16.h"
+
+/** A State Variable filter like StateVariable, tuned with the exact Chamberlin
+coefficient f = 2 * sin(pi * cutoff / fs).
+
+The coefficient is looked up from SVFCOEFF256_DATA, which holds 2 * sin(pi * x)
+for x = cutoff / AUDIO_RATE from 0 to 1/4, with linear interpolation.  Because the table
+is in terms of cutoff / AUDIO_RATE, the same table is in tune at any AUDIO_RATE.
+
+setCentreFreq() only sets the target coefficient, so it is cheap enough to call every
+control update.  next() jumps to the new coefficient, while process() interpolates from
+the previous coefficient to the new one across the block, so sweeps from LFOs or envelopes
+don't step at the control rate.
+@tparam FILTER_TYPE choose between LOWPASS, BANDPASS, HIGHPASS and NOTCH.
+@note Like StateVariable, this version does not saturate internally.
+*/
+template <int8_t FILTER_TYPE> class StateVariableTuned {
+
+public:
+  /** Constructor.
+   */
+  StateVariableTuned() : low(0), band(0), f(0), target_f(0) {
+    setResonance(128);
+  }
+
+  /** Set how resonant the filter will be.
+  @param resonance a byte value between 1 and 255.
+  The lower this value is, the more resonant the filter.  See StateVariable::setResonance().
+  */
+  void setResonance(Q0n8 resonance) {
+    q = resonance;
+    scale = (Q0n8)sqrt((unsigned int)resonance << 8);
+  }
+
+  /** Set the centre or corner frequency of the filter.
+  @param centre_freq 0 - AUDIO_RATE/4 Hz, higher values are clipped to AUDIO_RATE/4.
+  */
+  inline void setCentreFreq(unsigned int centre_freq) {
+    setCentreFreq_Q16n16((Q16n16)centre_freq << 16);
+  }
+
+  /** Set the centre or corner frequency of the filter, with a fractional part.
+  @param centre_freq 0 - AUDIO_RATE/4 Hz, in Q16n16 fixed point.
+  Higher values are clipped to AUDIO_RATE/4.
+  */
+  inline void setCentreFreq_Q16n16(Q16n16 centre_freq) {
+    const Q16n16 max_freq = (Q16n16)(AUDIO_RATE / 4) << 16;
+    if (centre_freq > max_freq) centre_freq = max_freq;
+    // cutoff / AUDIO_RATE in Q0n32, 0 to 1/4
+    const uint32_t x = centre_freq << (16 - AUDIO_RATE_AS_LSHIFT);
+    const unsigned int index = x >> 22;
+    if (index >= SVFCOEFF256_NUM_CELLS) {
+      target_f = FLASH_OR_RAM_READ<const uint16_t>(SVFCOEFF256_DATA + SVFCOEFF256_NUM_CELLS);
+      return;
+    }
+    const uint32_t fraction = (x >> 6) & 0xffff;
+    const int32_t a = FLASH_OR_RAM_READ<const uint16_t>(SVFCOEFF256_DATA + index);
+    const int32_t b = FLASH_OR_RAM_READ<const uint16_t>(SVFCOEFF256_DATA + index + 1);
+    target_f = a + (int32_t)(((b - a) * fraction) >> 16);
+  }
+
+  /** Set the centre or corner frequency of the filter from a midi note.
+  @param midi_note a midi note number in Q16n16 fixed point, for fractional notes.
+  */
+  inline void setCentreNote_Q16n16(Q16n16 midi_note) {
+    setCentreFreq_Q16n16(Q16n16_mtof(midi_note));
+  }
+
+  /** Calculate the next sample, given an input signal.
+  This uses the last frequency set, without interpolation.
+  @param input the signal input.
+  @return the signal output.
+  */
+  inline int next(int input) {
+    f = target_f;
+    return tick(input, f);
+  }
+
+  /** Filter a block of audio, interpolating the frequency coefficient from the
+  last one used to the one set by the last setCentreFreq() across the block.
+  @param in the signal input, n samples.
+  @param out receives the signal output, n samples.  It can be the same buffer as in.
+  @param n the number of samples.
+  */
+  void process(const int16_t * in, int16_t * out, unsigned int n) {
+    if (n == 0) return;
+    const int32_t step = (target_f - f) / (int32_t)n;
+    int32_t coeff = f;
+    for (unsigned int i = 0; i < n; ++i) {
+      coeff += step;
+      out[i] = (int16_t) tick(in[i], coeff);
+    }
+    f = target_f;
+  }
+
+private:
+  int32_t low, band;
+  Q0n8 q, scale;
+  int32_t f;         // coefficient in use, Q1n15
+  int32_t target_f;  // coefficient from the last setCentreFreq(), Q1n15
+
+  inline int tick(int input, int32_t coeff) {
+    low += (coeff * band) >> 15;
+    // scale only the input, as in the Chamberlin original, so the resonance does not detune it
+    const int32_t high = (((int32_t)input * scale) >> 8) - low - ((band * q) >> 8);
+    band += (coeff * high) >> 15;
+    // FILTER_TYPE is a constant, so this folds away
+    switch (FILTER_TYPE) {
+      case BANDPASS:
+        return band;
+      case HIGHPASS:
+        return high;
+      case NOTCH:
+        return high + low;
+      default:
+        return low;
+    }
+  }
+};
+
+#endif /* STATEVARIABLETUNED_H_ */
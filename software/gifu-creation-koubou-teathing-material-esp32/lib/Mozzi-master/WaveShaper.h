@@ -13,6 +13,8 @@
 #define WAVESHAPER_H_
 
 #include "Arduino.h"
+#include "mozzi_pgmspace.h"
+#include "HalfbandFilter.h"
 
 /** WaveShaper maps values from its input to values in a table, which are returned as output.
 @tparam T the type of numbers being input to be shaped, chosen to match the table.
@@ -97,6 +99,114 @@ private:
 	const int16_t * table;
 };
 
+
+/** A WaveShaper for 8 bit tables which runs the table at 2 or 4 times the sample rate.
+
+Driving WaveShaper<char> hard makes harmonics above the Nyquist frequency, which fold back as
+inharmonic aliases.  This one upsamples the input with HalfbandFilter, looks up the table
+between cells (with linear interpolation, so the upsampled values between the input samples
+give new values), and filters and downsamples the result, so most of those harmonics are removed
+before they can fold back.  At 4x there are two halfband stages each way, the second one shorter.
+
+OVERSAMPLING is a template parameter, so only the stages used are compiled, and their buffers
+are only as big as they need to be.  process() works in blocks of up to 32 samples.
+@tparam OVERSAMPLING 1, 2 or 4.  1 is WaveShaper<char> with interpolation between cells.
+*/
+template <uint8_t OVERSAMPLING>
+class OversampledWaveShaper
+{
+
+public:
+	/** Constructor.
+	@param TABLE_NAME the name of a 256 cell int8_t table, such as CHEBYSHEV_3RD_256_DATA.
+	*/
+	OversampledWaveShaper(const int8_t * TABLE_NAME): table(TABLE_NAME), stage1(HALFBAND_6_PAIRS), stage2(HALFBAND_3_PAIRS)
+	{
+		;
+	}
+
+
+	/** Maps input to output, like WaveShaper<char>::next().
+	@param in the input signal, offset so that 128 is the centre of the table.
+	@return the shaped signal.
+	*/
+	inline
+	int8_t next(byte in)
+	{
+		int16_t x = ((int16_t)in - 128) << 8;
+		process(&x, &x, 1);
+		return (int8_t)(x >> 8);
+	}
+
+
+	/** Shape a block of audio.
+	@param in the signal input, n signed 16 bit samples, where 0 is the centre of the table and
+	the ends of the table are -32768 and 32767.
+	@param out receives n samples of 16 bit output, the table values shifted up by 8.
+	It can be the same buffer as in.
+	@param n the number of samples.
+	*/
+	void process(const int16_t * in, int16_t * out, unsigned int n)
+	{
+		while (n) {
+			const unsigned int chunk = (n < BLOCK) ? n : BLOCK;
+			processBlock(in, out, chunk);
+			in += chunk;
+			out += chunk;
+			n -= chunk;
+		}
+	}
+
+private:
+	static const uint16_t BLOCK = 32;
+
+	const int8_t * table;
+	HalfbandFilter<6, (OVERSAMPLING >= 2) ? BLOCK : 1> stage1;
+	HalfbandFilter<3, (OVERSAMPLING >= 4) ? 2 * BLOCK : 1> stage2;
+
+
+	/* the table read between cells, for 15 bit samples, in place */
+	inline
+	void shape(int16_t * buf, unsigned int n)
+	{
+		for (unsigned int i = 0; i < n; ++i){
+			const int32_t x = constrain((int32_t)buf[i], -16384, 16383) + 16384;
+			const uint8_t index = x >> 7;
+			const int32_t a = FLASH_OR_RAM_READ<const int8_t>(table + index);
+			const int32_t b = (index == 255) ? a : FLASH_OR_RAM_READ<const int8_t>(table + index + 1);
+			buf[i] = (int16_t)((a << 7) + (b - a) * (x & 127));
+		}
+	}
+
+
+	void processBlock(const int16_t * in, int16_t * out, unsigned int n)
+	{
+		// 15 bits inside, to leave room for the filters
+		int16_t buf[BLOCK * OVERSAMPLING];
+		for (unsigned int i = 0; i < n; ++i) buf[i] = in[i] >> 1;
+
+		if (OVERSAMPLING == 4) {
+			int16_t up[BLOCK * 2];
+			stage1.upsample(buf, up, n);
+			stage2.upsample(up, buf, 2 * n);
+			shape(buf, 4 * n);
+			stage2.downsample(buf, up, 2 * n);
+			stage1.downsample(up, buf, n);
+		} else if (OVERSAMPLING == 2) {
+			int16_t up[BLOCK * 2];
+			stage1.upsample(buf, up, n);
+			shape(up, 2 * n);
+			stage1.downsample(up, buf, n);
+		} else {
+			shape(buf, n);
+		}
+
+		for (unsigned int i = 0; i < n; ++i){
+			out[i] = (int16_t)(constrain((int32_t)buf[i], -16384, 16383) << 1);
+		}
+	}
+};
+
 /** @example 06.Synthesis/WaveShaper/WaveShaper.ino
 This is an example of how to use the WaveShaper class.
 */
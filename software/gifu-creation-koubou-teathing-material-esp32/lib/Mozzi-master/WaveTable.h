@@ -0,0 +1,163 @@
+/*
+ * WaveTable.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef WAVETABLE_H_
+#define WAVETABLE_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "mozzi_pgmspace.h"
+
+/** Shapes for WaveTable.  The sine, triangle and square start at 0 or their top and are in phase
+with each other, the saw ramps up from the bottom. */
+enum WaveTableShape {
+	WAVE_SINE,
+	WAVE_COSINE,
+	WAVE_TRIANGLE,
+	WAVE_SAW,
+	WAVE_SQUARE
+};
+
+
+/** A wave table worked out by the compiler, instead of read from a header in tables/.
+
+WaveTable<WAVE_SINE, 2048>::DATA points to a CONSTTABLE_STORAGE array, and can be given to an
+Oscil like SIN2048_DATA:
+@code
+Oscil <2048, AUDIO_RATE> aSin(WaveTable<WAVE_SINE, 2048>::DATA);
+@endcode
+The array is a static member of a class template, so it is only in the program if it is used,
+and when several files use the same one, the linker keeps one copy.  The values are worked out
+with constexpr functions (a Taylor series for the sine), which only needs C++11, so this works
+with the same compilers as the rest of Mozzi.
+
+int16_t tables are available for every shape, for Oscil16 and the higher resolution output modes:
+@code
+Oscil16 <4096, AUDIO_RATE> aSin(WaveTable<WAVE_SINE, 4096, int16_t>::DATA);
+@endcode
+The saw and square are not band limited, so at high frequencies the ready made
+square_no_alias and saw tables in tables/ sound cleaner.
+@tparam SHAPE one of the WaveTableShape values.
+@tparam NUM_CELLS the length of the table, a power of two from 4 to 8192.
+@tparam T int8_t (-127 to 127) or int16_t (-32767 to 32767).
+*/
+template <uint8_t SHAPE, uint16_t NUM_CELLS, class T = int8_t>
+struct WaveTable;
+
+
+// the rest of this file is how WaveTable is put together at compile time
+
+template <class T> struct WaveTableAmplitude;
+template <> struct WaveTableAmplitude<int8_t> { static constexpr double VALUE = 127.0; };
+template <> struct WaveTableAmplitude<int16_t> { static constexpr double VALUE = 32767.0; };
+
+
+/* sin(x) for x from -pi/2 to pi/2, Taylor series to x^15 in Horner form */
+constexpr double wavetableSinTaylor(double x, double x2)
+{
+	return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110 * (1 - x2 / 156 * (1 - x2 / 210)))))));
+}
+
+
+/* sin(2 pi i / n), folded into the first quarter so the series stays accurate */
+constexpr double wavetableSine(uint32_t i, uint32_t n)
+{
+	return (i >= n / 2) ? -wavetableSine(i - n / 2, n)
+		: (4 * i > n) ? wavetableSine(n / 2 - i, n)
+		: wavetableSinTaylor(6.283185307179586 * i / n, (6.283185307179586 * i / n) * (6.283185307179586 * i / n));
+}
+
+
+constexpr double wavetableShape(uint8_t shape, uint32_t i, uint32_t n)
+{
+	return (shape == WAVE_SINE) ? wavetableSine(i, n)
+		: (shape == WAVE_COSINE) ? wavetableSine((i + n / 4) % n, n)
+		: (shape == WAVE_TRIANGLE) ? ((4 * i < n) ? 4.0 * i / n : (4 * i < 3 * n) ? 2.0 - 4.0 * i / n : 4.0 * i / n - 4.0)
+		: (shape == WAVE_SAW) ? 2.0 * i / n - 1.0
+		: ((2 * i < n) ? 1.0 : -1.0);
+}
+
+
+template <unsigned int... I> struct WaveTableIndices {};
+
+template <class A, class B> struct WaveTableJoin;
+template <unsigned int... I, unsigned int... J>
+struct WaveTableJoin<WaveTableIndices<I...>, WaveTableIndices<J...> >
+{
+	typedef WaveTableIndices<I..., (sizeof...(I) + J)...> type;
+};
+
+/* 0 to N - 1, built by halves so the template nesting is only log2(N) deep */
+template <unsigned int N> struct MakeWaveTableIndices
+{
+	typedef typename WaveTableJoin<typename MakeWaveTableIndices<N / 2>::type, typename MakeWaveTableIndices<N - N / 2>::type>::type type;
+};
+template <> struct MakeWaveTableIndices<0> { typedef WaveTableIndices<> type; };
+template <> struct MakeWaveTableIndices<1> { typedef WaveTableIndices<0> type; };
+
+
+/* the table is kept in a struct so it can be returned from a constexpr function */
+template <class T, uint16_t NUM_CELLS>
+struct WaveTableCells
+{
+	T values[NUM_CELLS];
+};
+
+
+template <uint8_t SHAPE, uint16_t NUM_CELLS, class T>
+struct WaveTableGenerator
+{
+	typedef T type;
+	typedef WaveTableCells<T, NUM_CELLS> Cells;
+	typedef typename MakeWaveTableIndices<NUM_CELLS>::type Indices;
+
+	static constexpr T at(uint32_t i)
+	{
+		return static_cast<T>(toInteger(wavetableShape(SHAPE, i, NUM_CELLS) * WaveTableAmplitude<T>::VALUE));
+	}
+
+	/* round half away from 0 */
+	static constexpr long toInteger(double x)
+	{
+		return (x >= 0) ? (long)(x + 0.5) : -(long)(0.5 - x);
+	}
+
+	template <unsigned int... I>
+	static constexpr Cells make(WaveTableIndices<I...>)
+	{
+		return Cells {{ at(I)... }};
+	}
+};
+
+
+/* one template parameter, so the storage type can go through CONSTTABLE_STORAGE() without a comma */
+template <class GENERATOR>
+struct WaveTableStorage
+{
+	static constexpr typename GENERATOR::Cells CELLS = GENERATOR::make(typename GENERATOR::Indices());
+	static constexpr const typename GENERATOR::type * DATA = CELLS.values;
+};
+
+template <class GENERATOR>
+constexpr CONSTTABLE_STORAGE(typename GENERATOR::Cells) WaveTableStorage<GENERATOR>::CELLS;
+
+template <class GENERATOR>
+constexpr const typename GENERATOR::type * WaveTableStorage<GENERATOR>::DATA;
+
+
+template <uint8_t SHAPE, uint16_t NUM_CELLS, class T>
+struct WaveTable: public WaveTableStorage<WaveTableGenerator<SHAPE, NUM_CELLS, T> >
+{
+};
+
+#endif        //  #ifndef WAVETABLE_H_
@@ -0,0 +1,115 @@
+/*  Measures how many processor cycles Oscil16 takes for each sample,
+    with next() and render(), plain and interpolated, next to Oscil
+    playing the 8 bit version of the same 4096 cell cosine, and prints
+    how many oscillators would fit in the time between two audio samples
+    on one core.
+
+    There is no sound, the results are printed to the serial monitor.
+
+    Circuit: not required
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <Oscil.h>
+#include <Oscil16.h>
+#include <tables/cos4096_int8.h>
+#include <tables/cos4096_int16.h>
+
+const unsigned int BLOCK = 64;
+const unsigned int NUM_BLOCKS = 512;
+
+int16_t out[BLOCK];
+
+Oscil <COS4096_NUM_CELLS, AUDIO_RATE> osc8(COS4096_DATA);
+Oscil16 <COS4096X16_NUM_CELLS, AUDIO_RATE> osc16(COS4096X16_DATA);
+Oscil16 <COS4096X16_NUM_CELLS, AUDIO_RATE, true> osc16Interp(COS4096X16_DATA);
+
+volatile long sink; // so the compiler keeps the results
+
+// cycles on the ESP32, otherwise worked out from micros()
+uint32_t cycles(){
+#if defined(ESP32)
+  return ESP.getCycleCount();
+#else
+  return micros() * (F_CPU / 1000000UL);
+#endif
+}
+
+
+void report(const char * name, uint32_t elapsed){
+  const float per_sample = (float)elapsed / ((long)BLOCK * NUM_BLOCKS);
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(per_sample, 1);
+  Serial.print(" cycles/sample, ");
+  Serial.print((long)(F_CPU / AUDIO_RATE / per_sample));
+  Serial.println(" oscillators per core");
+}
+
+
+template <class OSCIL>
+void benchNext(const char * name, OSCIL & osc){
+  long sum = 0;
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    for (unsigned int i = 0; i < BLOCK; ++i) sum += osc.next();
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = sum;
+  report(name, elapsed);
+}
+
+
+// Oscil has no render(), so this is what a block of it would be
+template <class OSCIL>
+void benchNextBlock(const char * name, OSCIL & osc){
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    for (unsigned int i = 0; i < BLOCK; ++i) out[i] = osc.next();
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = out[0];
+  report(name, elapsed);
+}
+
+
+template <class OSCIL>
+void benchRender(const char * name, OSCIL & osc){
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    osc.render(out, BLOCK);
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = out[0];
+  report(name, elapsed);
+}
+
+
+void setup(){
+  Serial.begin(115200);
+  delay(1000);
+
+  // not a whole number of cells per sample, so the interpolation has a fraction to work with
+  osc8.setFreq(441.3f);
+  osc16.setFreq(441.3f);
+  osc16Interp.setFreq(441.3f);
+
+  benchNext("Oscil next()", osc8);
+  benchNextBlock("Oscil next() block", osc8);
+  benchNext("Oscil16 next()", osc16);
+  benchRender("Oscil16 render()", osc16);
+  benchNext("Oscil16 interpolated next()", osc16Interp);
+  benchRender("Oscil16 interpolated render()", osc16Interp);
+}
+
+
+void loop(){
+}
@@ -0,0 +1,107 @@
+/*  Measures how many processor cycles a PluckedString takes for each
+    sample, by running a chord of strings for half a second from the
+    pluck, and prints how many strings would fit in the time between
+    two audio samples on one core.
+
+    There is no sound, the results are printed to the serial monitor.
+
+    Circuit: not required
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <PluckedString.h>
+
+const unsigned int BLOCK = 64;
+const unsigned int NUM_BLOCKS = AUDIO_RATE / 2 / BLOCK;
+const uint8_t NUM_STRINGS = 6;
+
+int16_t out[BLOCK];
+int32_t mix[BLOCK];
+
+PluckedString <512> strings[NUM_STRINGS];
+const float freqs[NUM_STRINGS] = {82.4f, 110.f, 146.8f, 196.f, 246.9f, 329.6f}; // guitar tuning
+
+volatile long sink; // so the compiler keeps the results
+
+// cycles on the ESP32, otherwise worked out from micros()
+uint32_t cycles(){
+#if defined(ESP32)
+  return ESP.getCycleCount();
+#else
+  return micros() * (F_CPU / 1000000UL);
+#endif
+}
+
+
+void report(const char * name, uint32_t elapsed){
+  // per string
+  const float per_sample = (float)elapsed / ((long)BLOCK * NUM_BLOCKS * NUM_STRINGS);
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(per_sample, 1);
+  Serial.print(" cycles/sample per string, ");
+  Serial.print((long)(F_CPU / AUDIO_RATE / per_sample));
+  Serial.println(" strings per core");
+}
+
+
+void pluckAll(){
+  for (uint8_t s = 0; s < NUM_STRINGS; ++s){
+    strings[s].mute();
+    strings[s].pluck();
+  }
+}
+
+
+void benchNext(){
+  pluckAll();
+  long sum = 0;
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    for (unsigned int i = 0; i < BLOCK; ++i){
+      for (uint8_t s = 0; s < NUM_STRINGS; ++s) sum += strings[s].next();
+    }
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = sum;
+  report("next()", elapsed);
+}
+
+
+void benchProcess(){
+  pluckAll();
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    memset(mix, 0, sizeof(mix));
+    for (uint8_t s = 0; s < NUM_STRINGS; ++s){
+      strings[s].process(out, BLOCK);
+      for (unsigned int i = 0; i < BLOCK; ++i) mix[i] += out[i];
+    }
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = mix[0];
+  report("process()", elapsed);
+}
+
+
+void setup(){
+  Serial.begin(115200);
+  delay(1000);
+
+  for (uint8_t s = 0; s < NUM_STRINGS; ++s) strings[s].setFreq(freqs[s]);
+
+  benchNext();
+  benchProcess();
+}
+
+
+void loop(){
+}
@@ -0,0 +1,92 @@
+/*  Checks that Sample::render() and Sample::mix() give the same output
+    as calling Sample::next() for each sample, with INTERP_NONE,
+    INTERP_LINEAR and INTERP_HERMITE, played once, looped over the whole
+    sample and looped between a start and end, at pitches from well below
+    to far above the recorded pitch.
+
+    There is no sound, the results are printed to the serial monitor.
+
+    Circuit: not required
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <Sample.h>
+#include <samples/bamboo/bamboo_00_4096_int8.h>
+
+const unsigned int BLOCK = 97; // not a power of two, so the blocks end all over the sample
+const unsigned int NUM_BLOCKS = 1000;
+const float freqs[] = {0.37f, 1.f, 3.3f, 8.f, 61.f, 500.f, 8000.f};
+
+int16_t expected[BLOCK];
+int16_t out[BLOCK];
+
+
+template <uint8_t INTERP>
+long check(const char * name){
+  long mismatches = 0;
+  for (uint8_t mode = 0; mode < 3; ++mode){
+    for (uint8_t f = 0; f < sizeof(freqs) / sizeof(freqs[0]); ++f){
+      Sample <BAMBOO_00_4096_NUM_CELLS, AUDIO_RATE, INTERP> byNext(BAMBOO_00_4096_DATA);
+      Sample <BAMBOO_00_4096_NUM_CELLS, AUDIO_RATE, INTERP> byBlock(BAMBOO_00_4096_DATA);
+      byNext.setFreq(freqs[f]);
+      byBlock.setFreq(freqs[f]);
+      if (mode > 0) {
+        byNext.setLoopingOn();
+        byBlock.setLoopingOn();
+      }
+      if (mode == 2) {
+        byNext.setEnd(1733);
+        byBlock.setEnd(1733);
+      }
+      byNext.start();
+      byBlock.start();
+      // played from the beginning, then looped between 1000 and 1733
+      if (mode == 2) {
+        byNext.setStart(1000);
+        byBlock.setStart(1000);
+      }
+
+      for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+        for (unsigned int i = 0; i < BLOCK; ++i) expected[i] = byNext.next();
+        // render() and mix() in turn, mix() into a block which isn't 0
+        if (b & 1) {
+          byBlock.render(out, BLOCK);
+        } else {
+          for (unsigned int i = 0; i < BLOCK; ++i) out[i] = 5;
+          byBlock.mix(out, BLOCK);
+          for (unsigned int i = 0; i < BLOCK; ++i) out[i] -= 5;
+        }
+        for (unsigned int i = 0; i < BLOCK; ++i){
+          if (out[i] != expected[i]) mismatches++;
+        }
+      }
+    }
+  }
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(mismatches);
+  Serial.println(mismatches ? " samples differ, FAIL" : " samples differ, ok");
+  return mismatches;
+}
+
+
+void setup(){
+  Serial.begin(115200);
+  delay(1000);
+
+  check<INTERP_NONE>("INTERP_NONE");
+  check<INTERP_LINEAR>("INTERP_LINEAR");
+  check<INTERP_HERMITE>("INTERP_HERMITE");
+}
+
+
+void loop(){
+}
@@ -0,0 +1,104 @@
+/*  Measures how many processor cycles ReverbTank and ReverbFDN take
+    for each sample, with next() and with block process(), and prints
+    them with the share of the time between two audio samples.
+
+    There is no sound, the results are printed to the serial monitor.
+
+    Circuit: not required
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <ReverbTank.h>
+#include <ReverbFDN.h>
+#include <mozzi_rand.h>
+
+const unsigned int BLOCK = 64;
+const unsigned int NUM_BLOCKS = 512;
+
+int16_t in[BLOCK];
+int16_t out[BLOCK];
+
+ReverbTank tank;
+ReverbFDN <4> fdn4;
+ReverbFDN <8> fdn8;
+
+volatile long sink; // so the compiler keeps the results
+
+// cycles on the ESP32, otherwise worked out from micros()
+uint32_t cycles(){
+#if defined(ESP32)
+  return ESP.getCycleCount();
+#else
+  return micros() * (F_CPU / 1000000UL);
+#endif
+}
+
+
+void report(const char * name, uint32_t elapsed){
+  const float per_sample = (float)elapsed / ((long)BLOCK * NUM_BLOCKS);
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(per_sample, 1);
+  Serial.print(" cycles/sample, ");
+  Serial.print(100.f * per_sample * AUDIO_RATE / F_CPU, 1);
+  Serial.println("% of the audio rate");
+}
+
+
+// full scale noise for the reverbs, and 8 bits for ReverbTank
+void fillInput(uint8_t shift){
+  for (unsigned int i = 0; i < BLOCK; ++i) in[i] = (int16_t)xorshift96() >> shift;
+}
+
+
+template <class REVERB>
+void benchNext(const char * name, REVERB & reverb){
+  long sum = 0;
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    for (unsigned int i = 0; i < BLOCK; ++i) sum += reverb.next(in[i]);
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = sum;
+  report(name, elapsed);
+}
+
+
+template <class REVERB>
+void benchProcess(const char * name, REVERB & reverb){
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    reverb.process(in, out, BLOCK);
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = out[0];
+  report(name, elapsed);
+}
+
+
+void setup(){
+  Serial.begin(115200);
+  delay(1000);
+
+  fillInput(8);
+  benchNext("ReverbTank next()", tank);
+  benchProcess("ReverbTank process()", tank);
+
+  fillInput(1);
+  benchNext("ReverbFDN<4> next()", fdn4);
+  benchProcess("ReverbFDN<4> process()", fdn4);
+  benchNext("ReverbFDN<8> next()", fdn8);
+  benchProcess("ReverbFDN<8> process()", fdn8);
+}
+
+
+void loop(){
+}
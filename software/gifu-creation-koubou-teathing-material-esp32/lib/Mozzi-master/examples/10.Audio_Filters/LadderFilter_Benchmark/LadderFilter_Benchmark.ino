@@ -0,0 +1,102 @@
+/*  Measures how many processor cycles LadderFilter takes for each
+    sample, in 4 and 2 pole mode, with next() and with block process(),
+    and prints them with the share of the time between two audio samples
+    and how many filters would fit in it.
+
+    There is no sound, the results are printed to the serial monitor.
+
+    Circuit: not required
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <LadderFilter.h>
+#include <mozzi_rand.h>
+
+const unsigned int BLOCK = 64;
+const unsigned int NUM_BLOCKS = 512;
+
+int16_t in[BLOCK];
+int16_t out[BLOCK];
+
+LadderFilter lpf;
+
+volatile long sink; // so the compiler keeps the results
+
+// cycles on the ESP32, otherwise worked out from micros()
+uint32_t cycles(){
+#if defined(ESP32)
+  return ESP.getCycleCount();
+#else
+  return micros() * (F_CPU / 1000000UL);
+#endif
+}
+
+
+void report(const char * name, uint32_t elapsed){
+  const float per_sample = (float)elapsed / ((long)BLOCK * NUM_BLOCKS);
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(per_sample, 1);
+  Serial.print(" cycles/sample, ");
+  Serial.print(100.f * per_sample * AUDIO_RATE / F_CPU, 1);
+  Serial.print("% of the audio rate, ");
+  Serial.print((long)(F_CPU / AUDIO_RATE / per_sample));
+  Serial.println(" filters would fit");
+}
+
+
+void benchNext(const char * name){
+  long sum = 0;
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    for (unsigned int i = 0; i < BLOCK; ++i) sum += lpf.next(in[i]);
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = sum;
+  report(name, elapsed);
+}
+
+
+void benchProcess(const char * name){
+  uint32_t start = cycles();
+  for (unsigned int b = 0; b < NUM_BLOCKS; ++b){
+    // a new cutoff every block, so process() interpolates
+    lpf.setCutoffFreq(500 + (b & 63) * 40);
+    lpf.process(in, out, BLOCK);
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = out[0];
+  report(name, elapsed);
+}
+
+
+void setup(){
+  Serial.begin(115200);
+  delay(1000);
+
+  // 15 bit noise
+  for (unsigned int i = 0; i < BLOCK; ++i) in[i] = (int16_t)xorshift96() >> 1;
+
+  lpf.setCutoffFreq(1500);
+  lpf.setResonance(200);
+
+  lpf.setPoles(4);
+  benchNext("4 pole next()");
+  benchProcess("4 pole process()");
+
+  lpf.setPoles(2);
+  benchNext("2 pole next()");
+  benchProcess("2 pole process()");
+}
+
+
+void loop(){
+}
@@ -0,0 +1,59 @@
+/*  Checks Q16n16_log2() from mozzi_fixmath.h: exact powers of 2 above
+    and below 1.0, and random numbers of every size from 1/65536 up,
+    against log2() in floating point.  It prints the largest error in
+    cents, which should stay under 0.02.
+
+    There is no sound, the results are printed to the serial monitor.
+
+    Circuit: not required
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <mozzi_fixmath.h>
+#include <mozzi_rand.h>
+#include <math.h>
+
+const unsigned int NUM_RANDOM = 2000; // for each size
+
+
+void setup(){
+  Serial.begin(115200);
+  delay(1000);
+
+  // powers of 2 give whole octaves, 1/65536 up to 32768
+  long wrong = 0;
+  for (uint8_t bit = 0; bit < 32; ++bit){
+    const Q15n16 expected = ((Q15n16)bit - 16) * 65536;
+    if (Q16n16_log2((Q16n16)1 << bit) != expected) wrong++;
+  }
+  if (Q16n16_log2(0x8000) != -65536) wrong++; // 0.5
+  if (Q16n16_log2(0) != -16 * 65536L) wrong++;
+  Serial.print("powers of 2\t");
+  Serial.print(wrong);
+  Serial.println(wrong ? " wrong, FAIL" : " wrong, ok");
+
+  // random numbers with the top bit at each place, so under 1.0 as well as over
+  float worst = 0;
+  for (uint8_t top = 0; top < 32; ++top){
+    for (unsigned int i = 0; i < NUM_RANDOM; ++i){
+      const Q16n16 x = (((Q16n16)1 << top) | ((Q16n16)xorshift96() & (((Q16n16)1 << top) - 1)));
+      const float cents = 1200.f * ((float)Q16n16_log2(x) / 65536.f - (float)(log2((double)x) - 16.0));
+      if (fabs(cents) > worst) worst = fabs(cents);
+    }
+  }
+  Serial.print("random\t\t");
+  Serial.print(worst, 4);
+  Serial.println(worst < 0.02f ? " cents at most, ok" : " cents at most, FAIL");
+}
+
+
+void loop(){
+}
@@ -0,0 +1,140 @@
+/*  Checks each multiply in mozzi_mult.h against the same multiply done
+    in plain C with 64 bits, for edge cases and random operands, and
+    times both, so the speedup of the version picked for this processor
+    can be seen (MULSH on the ESP32, SMULWB on ARM with the DSP
+    instructions, the assembly from mult16x16.h on AVR).
+
+    There is no sound, the results are printed to the serial monitor.
+
+    Circuit: not required
+
+		Mozzi documentation/API
+		https://sensorium.github.io/Mozzi/doc/html/index.html
+
+		Mozzi help/discussion/announcements:
+    https://groups.google.com/forum/#!forum/mozzi-users
+
+    CC by-nc-sa.
+*/
+
+#include <MozziGuts.h>
+#include <mozzi_mult.h>
+#include <mozzi_rand.h>
+
+const unsigned int NUM_OPERANDS = 64;
+const unsigned int NUM_RANDOM = 20000;
+const unsigned int NUM_REPEATS = 200;
+
+int32_t a[NUM_OPERANDS];
+int32_t b[NUM_OPERANDS];
+
+const int32_t edges[] = {0, 1, -1, 2, -2, 0x7fff, -0x8000, 0xffff, 0x10000, -0x10000,
+                         0x7fffffff, (int32_t)0x80000000, 0x40000000, -0x40000000, 12345678, -87654321};
+const unsigned int NUM_EDGES = sizeof(edges) / sizeof(edges[0]);
+
+volatile long sink; // so the compiler keeps the results
+
+// cycles on the ESP32, otherwise worked out from micros()
+uint32_t cycles(){
+#if defined(ESP32)
+  return ESP.getCycleCount();
+#else
+  return micros() * (F_CPU / 1000000UL);
+#endif
+}
+
+
+// the 64 bit reference for each, cut to the size of the result as the multiplies are
+int32_t ref_u16x16(int32_t x, int32_t y) { return (int32_t)((uint64_t)(uint16_t)x * (uint16_t)y); }
+int32_t ref_u16x16_h16(int32_t x, int32_t y) { return (uint16_t)(((uint64_t)(uint16_t)x * (uint16_t)y) >> 16); }
+int32_t ref_s16x16(int32_t x, int32_t y) { return (int32_t)((int64_t)(int16_t)x * (int16_t)y); }
+int32_t ref_s16x16_h16(int32_t x, int32_t y) { return (int16_t)(((int64_t)(int16_t)x * (int16_t)y) >> 16); }
+int32_t ref_s32x32_h32(int32_t x, int32_t y) { return (int32_t)(((int64_t)x * y) >> 32); }
+int32_t ref_s32x16_h32(int32_t x, int32_t y) { return (int32_t)(((int64_t)x * (int16_t)y) >> 16); }
+int32_t ref_s32xu16_h32(int32_t x, int32_t y) { return (int32_t)(((int64_t)x * (uint16_t)y) >> 16); }
+template <uint8_t SHIFT>
+int32_t ref_s32x32_shr(int32_t x, int32_t y) { return (int32_t)(((int64_t)x * y) >> SHIFT); }
+
+int32_t fast_u16x16(int32_t x, int32_t y) { return (int32_t)mult_u16x16((uint16_t)x, (uint16_t)y); }
+int32_t fast_u16x16_h16(int32_t x, int32_t y) { return mult_u16x16_h16((uint16_t)x, (uint16_t)y); }
+int32_t fast_s16x16(int32_t x, int32_t y) { return mult_s16x16((int16_t)x, (int16_t)y); }
+int32_t fast_s16x16_h16(int32_t x, int32_t y) { return mult_s16x16_h16((int16_t)x, (int16_t)y); }
+int32_t fast_s32x32_h32(int32_t x, int32_t y) { return mult_s32x32_h32(x, y); }
+int32_t fast_s32x16_h32(int32_t x, int32_t y) { return mult_s32x16_h32(x, (int16_t)y); }
+int32_t fast_s32xu16_h32(int32_t x, int32_t y) { return mult_s32xu16_h32(x, (uint16_t)y); }
+template <uint8_t SHIFT>
+int32_t fast_s32x32_shr(int32_t x, int32_t y) { return mult_s32x32_shr<SHIFT>(x, y); }
+
+
+// the multiplies are inlined into the loop, so the time is for the multiply and the sum
+template <int32_t (*MULT)(int32_t, int32_t)>
+uint32_t timeIt(){
+  long sum = 0;
+  uint32_t start = cycles();
+  for (unsigned int r = 0; r < NUM_REPEATS; ++r){
+    for (unsigned int i = 0; i < NUM_OPERANDS; ++i) sum += MULT(a[i], b[i]);
+  }
+  uint32_t elapsed = cycles() - start;
+  sink = sum;
+  return elapsed;
+}
+
+
+template <int32_t (*FAST)(int32_t, int32_t), int32_t (*REF)(int32_t, int32_t)>
+void check(const char * name){
+  long mismatches = 0;
+  for (unsigned int i = 0; i < NUM_EDGES; ++i){
+    for (unsigned int j = 0; j < NUM_EDGES; ++j){
+      if (FAST(edges[i], edges[j]) != REF(edges[i], edges[j])) mismatches++;
+    }
+  }
+  for (unsigned int i = 0; i < NUM_RANDOM; ++i){
+    const int32_t x = (int32_t)xorshift96();
+    const int32_t y = (int32_t)xorshift96();
+    if (FAST(x, y) != REF(x, y)) mismatches++;
+  }
+
+  const float per_fast = (float)timeIt<FAST>() / ((long)NUM_REPEATS * NUM_OPERANDS);
+  const float per_ref = (float)timeIt<REF>() / ((long)NUM_REPEATS * NUM_OPERANDS);
+
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(mismatches ? "FAIL, " : "ok, ");
+  Serial.print(mismatches);
+  Serial.print(" wrong, ");
+  Serial.print(per_fast, 1);
+  Serial.print(" cycles vs ");
+  Serial.print(per_ref, 1);
+  Serial.print(" for 64 bit C, ");
+  Serial.print(per_ref / per_fast, 2);
+  Serial.println("x");
+}
+
+
+void setup(){
+  Serial.begin(115200);
+  delay(1000);
+
+  for (unsigned int i = 0; i < NUM_OPERANDS; ++i){
+    a[i] = (int32_t)xorshift96();
+    b[i] = (int32_t)xorshift96();
+  }
+
+  check<fast_u16x16, ref_u16x16>("mult_u16x16");
+  check<fast_u16x16_h16, ref_u16x16_h16>("mult_u16x16_h16");
+  check<fast_s16x16, ref_s16x16>("mult_s16x16");
+  check<fast_s16x16_h16, ref_s16x16_h16>("mult_s16x16_h16");
+  check<fast_s32x32_h32, ref_s32x32_h32>("mult_s32x32_h32");
+  check<fast_s32x32_shr<1>, ref_s32x32_shr<1> >("mult_s32x32_shr<1>");
+  check<fast_s32x32_shr<15>, ref_s32x32_shr<15> >("mult_s32x32_shr<15>");
+  check<fast_s32x32_shr<16>, ref_s32x32_shr<16> >("mult_s32x32_shr<16>");
+  check<fast_s32x32_shr<24>, ref_s32x32_shr<24> >("mult_s32x32_shr<24>");
+  check<fast_s32x32_shr<31>, ref_s32x32_shr<31> >("mult_s32x32_shr<31>");
+  check<fast_s32x32_shr<32>, ref_s32x32_shr<32> >("mult_s32x32_shr<32>");
+  check<fast_s32x16_h32, ref_s32x16_h32>("mult_s32x16_h32");
+  check<fast_s32xu16_h32, ref_s32xu16_h32>("mult_s32xu16_h32");
+}
+
+
+void loop(){
+}
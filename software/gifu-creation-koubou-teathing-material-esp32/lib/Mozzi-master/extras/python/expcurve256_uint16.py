@@ -0,0 +1,35 @@
+## generates an exponential (RC charge) curve from 0 to 65535, for ADSRCurved.
+## 257 cells so the last cell can be used for interpolation.
+
+import os
+import textwrap
+import math
+
+def generate(outfile, tablename, tablelength, k):
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n \n')
+    fout.write('#if ARDUINO >= 100'+'\n')
+    fout.write('#include "Arduino.h"'+'\n')
+    fout.write('#else'+'\n')
+    fout.write('#include "WProgram.h"'+'\n')
+    fout.write('#endif'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n \n')
+    fout.write('/* (1 - exp(-' + str(k) + 'x)) / (1 - exp(-' + str(k) + ')), x = 0 to 1, plus one guard cell */\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(tablelength)+'\n \n')
+    outstring = 'CONSTTABLE_STORAGE(uint16_t) ' + tablename + '_DATA [] = {'
+
+    try:
+        for num in range(tablelength + 1):
+            x = float(num)/tablelength
+            t_x = (1 - math.exp(-k*x)) / (1 - math.exp(-k))
+            scaled = int(round(t_x*65535))
+            outstring += str(scaled) + ', '
+    finally:
+        outstring = textwrap.fill(outstring, 80)
+        outstring += '\n }; \n \n #endif /* ' + tablename + '_H_ */\n'
+        fout.write(outstring)
+        fout.close()
+        print("wrote " + outfile)
+
+generate("tables/expcurve256_uint16.h", "EXPCURVE256", 256, 4.0)
@@ -0,0 +1,65 @@
+## resamples an int8 Mozzi sound header from one sample rate to another, so one
+## set of sounds can be baked for a 16384 or a 32768 Hz build without going back
+## to the original recordings.
+## usage: resample_rate.py infile outfile TABLENAME from_rate to_rate
+## It uses the same Kaiser windowed sinc as tables/sinc256_int16.h, but wider
+## (16 samples either side) since it only runs once, with the cutoff lowered to
+## the new Nyquist frequency when going down in rate.
+
+import os
+import sys
+import math
+import textwrap
+
+from resample_table import read_table
+from sinc256_int16 import kernel
+
+HALF_WIDTH = 16
+BETA = 8.0
+
+def resample(values, from_rate, to_rate):
+    n = len(values)
+    ratio = float(from_rate) / to_rate   # input samples per output sample
+    scale = min(1.0, 1.0 / ratio)        # narrows the passband when going down
+    reach = int(math.ceil(HALF_WIDTH / scale))
+    out = []
+    for num in range(int(n / ratio)):
+        pos = num * ratio
+        centre = int(pos)
+        total = 0.0
+        for k in range(centre - reach + 1, centre + reach + 1):
+            if 0 <= k < n:
+                total += values[k] * kernel((k - pos) * scale, HALF_WIDTH, 0.9, BETA)
+        out.append(total * scale)
+    return out
+
+def generate(infile, outfile, tablename, from_rate, to_rate):
+    values = resample(read_table(infile), from_rate, to_rate)
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n \n')
+    fout.write('#if ARDUINO >= 100'+'\n')
+    fout.write('#include "Arduino.h"'+'\n')
+    fout.write('#else'+'\n')
+    fout.write('#include "WProgram.h"'+'\n')
+    fout.write('#endif'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n \n')
+    fout.write('/* ' + os.path.basename(infile) + ' resampled from ' + str(from_rate) + ' to ' + str(to_rate) + ' Hz */\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(len(values))+'\n')
+    fout.write('#define ' + tablename + '_SAMPLERATE '+ str(to_rate)+'\n \n')
+    outstring = 'CONSTTABLE_STORAGE(int8_t) ' + tablename + '_DATA [] = {'
+    try:
+        for v in values:
+            outstring += str(max(-128, min(127, int(round(v))))) + ', '
+    finally:
+        outstring = textwrap.fill(outstring, 80)
+        outstring += '\n }; \n \n #endif /* ' + tablename + '_H_ */\n'
+        fout.write(outstring)
+        fout.close()
+        print("wrote " + outfile)
+
+if __name__ == '__main__':
+    if len(sys.argv) != 6:
+        print('usage: resample_rate.py infile outfile TABLENAME from_rate to_rate')
+        sys.exit(1)
+    generate(sys.argv[1], sys.argv[2], sys.argv[3], int(sys.argv[4]), int(sys.argv[5]))
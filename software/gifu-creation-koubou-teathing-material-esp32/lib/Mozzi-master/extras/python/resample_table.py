@@ -0,0 +1,62 @@
+## resamples an int8 Mozzi table header to another length, so tables of
+## different sizes can share one phase, for example in MorphOscil.
+## usage: resample_table.py infile outfile TABLENAME length
+## When shortening, each output cell is the average of the input cells it
+## covers, which keeps the aliasing down; when lengthening it interpolates.
+
+import os
+import re
+import sys
+import textwrap
+
+def read_table(infile):
+    text = open(os.path.expanduser(infile)).read()
+    body = text[text.index('{', text.index('_DATA')) + 1:text.index('}', text.index('_DATA'))]
+    return [int(v) for v in re.findall(r'-?\d+', body)]
+
+def resample(values, tablelength):
+    n = len(values)
+    out = []
+    step = float(n) / tablelength
+    for num in range(tablelength):
+        start = num * step
+        if step > 1.0:
+            first = int(start)
+            last = min(int(start + step), n)
+            cells = values[first:last]
+            out.append(float(sum(cells)) / len(cells))
+        else:
+            i = int(start)
+            frac = start - i
+            out.append(values[i] * (1 - frac) + values[(i + 1) % n] * frac)
+    return out
+
+def generate(infile, outfile, tablename, tablelength):
+    values = resample(read_table(infile), tablelength)
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n \n')
+    fout.write('#if ARDUINO >= 100'+'\n')
+    fout.write('#include "Arduino.h"'+'\n')
+    fout.write('#else'+'\n')
+    fout.write('#include "WProgram.h"'+'\n')
+    fout.write('#endif'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n \n')
+    fout.write('/* ' + os.path.basename(infile) + ' resampled to ' + str(tablelength) + ' cells */\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(tablelength)+'\n \n')
+    outstring = 'CONSTTABLE_STORAGE(int8_t) ' + tablename + '_DATA [] = {'
+    try:
+        for v in values:
+            outstring += str(max(-128, min(127, int(round(v))))) + ', '
+    finally:
+        outstring = textwrap.fill(outstring, 80)
+        outstring += '\n }; \n \n #endif /* ' + tablename + '_H_ */\n'
+        fout.write(outstring)
+        fout.close()
+        print("wrote " + outfile)
+
+if __name__ == '__main__':
+    if len(sys.argv) != 5:
+        print('usage: resample_table.py infile outfile TABLENAME length')
+        sys.exit(1)
+    generate(sys.argv[1], sys.argv[2], sys.argv[3], int(sys.argv[4]))
@@ -0,0 +1,53 @@
+## generates one side of a Kaiser windowed sinc, for the polyphase interpolation in
+## ResampledSample.  x runs from 0 to 4 input samples, 64 cells to a sample, and the
+## cutoff is 0.9 of the Nyquist frequency, so the filter passes up to 0.45 of the
+## sample rate and is well down by the Nyquist frequency.
+## Values in Q0n15, 257 cells so the last cell can be used for interpolation.
+
+import os
+import textwrap
+import math
+
+def i0(x):
+    # modified Bessel function of the first kind, for the Kaiser window
+    total = 1.0
+    term = 1.0
+    for k in range(1, 40):
+        term *= (x / (2.0 * k)) ** 2
+        total += term
+    return total
+
+def kernel(x, half_width, cutoff, beta):
+    if abs(x) >= half_width:
+        return 0.0
+    s = cutoff if x == 0 else math.sin(math.pi * cutoff * x) / (math.pi * x)
+    return s * i0(beta * math.sqrt(1.0 - (x / half_width) ** 2)) / i0(beta)
+
+def generate(outfile, tablename, tablelength, half_width, cutoff, beta):
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n \n')
+    fout.write('#if ARDUINO >= 100'+'\n')
+    fout.write('#include "Arduino.h"'+'\n')
+    fout.write('#else'+'\n')
+    fout.write('#include "WProgram.h"'+'\n')
+    fout.write('#endif'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n \n')
+    fout.write('/* windowed sinc in Q0n15, x = 0 to ' + str(half_width) + ' samples, cutoff ' + str(cutoff) + ' of Nyquist, plus one guard cell */\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(tablelength)+'\n \n')
+    outstring = 'CONSTTABLE_STORAGE(int16_t) ' + tablename + '_DATA [] = {'
+
+    try:
+        for num in range(tablelength + 1):
+            x = half_width * float(num) / tablelength
+            scaled = int(round(kernel(x, half_width, cutoff, beta) * 32767))
+            outstring += str(scaled) + ', '
+    finally:
+        outstring = textwrap.fill(outstring, 80)
+        outstring += '\n }; \n \n #endif /* ' + tablename + '_H_ */\n'
+        fout.write(outstring)
+        fout.close()
+        print("wrote " + outfile)
+
+if __name__ == '__main__':
+    generate("tables/sinc256_int16.h", "SINC256", 256, 4, 0.9, 6.0)
@@ -0,0 +1,37 @@
+## generates the StateVariableTuned frequency coefficient 2 * sin(pi * f / fs)
+## for f / fs = 0 to 1/4, in Q1n15.  The table is in terms of f / fs, so it
+## works for any AUDIO_RATE.
+## 257 cells so the last cell can be used for interpolation.
+
+import os
+import textwrap
+import math
+
+def generate(outfile, tablename, tablelength):
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n \n')
+    fout.write('#if ARDUINO >= 100'+'\n')
+    fout.write('#include "Arduino.h"'+'\n')
+    fout.write('#else'+'\n')
+    fout.write('#include "WProgram.h"'+'\n')
+    fout.write('#endif'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n \n')
+    fout.write('/* 2 * sin(pi * x) in Q1n15, x = f / fs = 0 to 1/4, plus one guard cell */\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(tablelength)+'\n \n')
+    outstring = 'CONSTTABLE_STORAGE(uint16_t) ' + tablename + '_DATA [] = {'
+
+    try:
+        for num in range(tablelength + 1):
+            x = 0.25 * float(num)/tablelength
+            t_x = 2.0 * math.sin(math.pi * x)
+            scaled = int(round(t_x*32768))
+            outstring += str(scaled) + ', '
+    finally:
+        outstring = textwrap.fill(outstring, 80)
+        outstring += '\n }; \n \n #endif /* ' + tablename + '_H_ */\n'
+        fout.write(outstring)
+        fout.close()
+        print("wrote " + outfile)
+
+generate("tables/svfcoeff256_uint16.h", "SVFCOEFF256", 256)
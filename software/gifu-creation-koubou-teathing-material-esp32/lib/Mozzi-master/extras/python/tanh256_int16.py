@@ -0,0 +1,35 @@
+## generates tanh(x) for x = -4 to 4, in Q0n15, for the saturation in LadderFilter.
+## 257 cells so the last cell can be used for interpolation.
+
+import os
+import textwrap
+import math
+
+def generate(outfile, tablename, tablelength, x_range):
+    fout = open(os.path.expanduser(outfile), "w")
+    fout.write('#ifndef ' + tablename + '_H_' + '\n')
+    fout.write('#define ' + tablename + '_H_' + '\n \n')
+    fout.write('#if ARDUINO >= 100'+'\n')
+    fout.write('#include "Arduino.h"'+'\n')
+    fout.write('#else'+'\n')
+    fout.write('#include "WProgram.h"'+'\n')
+    fout.write('#endif'+'\n')
+    fout.write('#include "mozzi_pgmspace.h"'+'\n \n')
+    fout.write('/* tanh(x) in Q0n15, x = -' + str(x_range) + ' to ' + str(x_range) + ', plus one guard cell */\n')
+    fout.write('#define ' + tablename + '_NUM_CELLS '+ str(tablelength)+'\n \n')
+    outstring = 'CONSTTABLE_STORAGE(int16_t) ' + tablename + '_DATA [] = {'
+
+    try:
+        for num in range(tablelength + 1):
+            x = x_range * (2.0 * float(num)/tablelength - 1.0)
+            t_x = math.tanh(x)
+            scaled = int(round(t_x*32767))
+            outstring += str(scaled) + ', '
+    finally:
+        outstring = textwrap.fill(outstring, 80)
+        outstring += '\n }; \n \n #endif /* ' + tablename + '_H_ */\n'
+        fout.write(outstring)
+        fout.close()
+        print("wrote " + outfile)
+
+generate("tables/tanh256_int16.h", "TANH256", 256, 4)
@@ -18,6 +18,8 @@
  #include "WProgram.h"
 #endif
 
+#include "mozzi_mult.h"
+
 /**@ingroup fixmath
 @{
 */
@@ -338,7 +340,86 @@ Fast fixed point multiply for Q7n8 fractional numbers.
 */
 inline
 Q7n8 Q7n8_mult(Q7n8 a, Q7n8 b) {
-  return ((int16_t)((((int32_t)(a))*(b))>>8));
+  return ((int16_t)(mult_s16x16(a, b)>>8));
+}
+
+
+/** @ingroup fixmath
+Fixed point multiply for Q15n16 numbers, without the overflow of a 32 bit multiply.
+@param a Q15n16 format multiplicand
+@param b Q15n16 format multiplier
+@return a Q15n16 format product
+*/
+inline
+Q15n16 Q15n16_mult(Q15n16 a, Q15n16 b) {
+  return mult_s32x32_shr<16>(a, b);
+}
+
+
+/* 2^(k/16) for k from 0 to 15, in Q2n30 */
+static const uint32_t EXP2_SIXTEENTHS[16] = {1073741824, 1121280436, 1170923762, 1222764986,
+	1276901417, 1333434672, 1392470869, 1454120821, 1518500250, 1585730000, 1655936265, 1729250827,
+	1805811301, 1885761398, 1969251188, 2056437387};
+
+/** @ingroup fixmath
+2 to the power of a fraction, from 1 to almost 2.  The top 4 bits of the fraction pick a power
+from a table of 16, and the rest is done with 1 + r ln2 + (r ln2)^2 / 2, which is within
+0.03 cents everywhere, for a table read and three multiplies.
+@param fraction the fraction, in Q0n16.
+@return 2^fraction in Q2n30.
+*/
+inline
+uint32_t Q0n16_exp2_Q2n30(Q0n16 fraction) {
+  const uint32_t r = fraction & 0x0fff; // less than 1/16
+  const uint32_t linear = r * 45426; // r ln2 in Q0n32
+  const uint32_t t = linear >> 16;
+  const uint32_t polynomial = ((uint32_t)1 << 30) + (linear >> 2) + ((t * t) >> 3);
+  return (uint32_t)mult_s32x32_shr<30>(EXP2_SIXTEENTHS[fraction >> 12], polynomial);
+}
+
+
+/** @ingroup fixmath
+2 to the power of a signed number, for turning octaves, or cents / 1200, into a frequency ratio.
+This is fast enough to use at audio rate, for vibrato and glides in pitch.  See Q0n16_exp2_Q2n30()
+for the accuracy.
+@param octaves the power, in Q15n16, from -16 to just under 16.
+@return the ratio, in Q16n16.
+*/
+inline
+Q16n16 Q16n16_exp2(Q15n16 octaves) {
+  const int16_t whole = (int16_t)(octaves >> 16); // rounded down, so the fraction is positive
+  const uint32_t mantissa = Q0n16_exp2_Q2n30((Q0n16)octaves);
+  if (whole <= -16) return 0;
+  if (whole >= 16) return 0xffffffff;
+  return (whole >= 14) ? (mantissa << (whole - 14)) : (mantissa >> (14 - whole));
+}
+
+
+/** @ingroup fixmath
+Log base 2, the inverse of Q16n16_exp2(), for turning a frequency ratio into octaves.  It uses the
+same table as Q16n16_exp2() and a division, so it is meant for control rate, for example to
+work out a glide once per note.  It is within 0.02 cents.
+@param x the number, in Q16n16, more than 0.
+@return log2(x) in Q15n16, from -16 to 16.
+*/
+inline
+Q15n16 Q16n16_log2(Q16n16 x) {
+  if (x == 0) return -((Q15n16)16 << 16);
+  // the highest bit set, with the clz for a 32 bit type (unsigned int is 16 bits on AVR, unsigned long 64 on a host)
+  const uint8_t top = 31 - ((sizeof(unsigned int) == 4) ? __builtin_clz((unsigned int)x) : (__builtin_clzl((unsigned long)x) - (int)(8 * sizeof(unsigned long) - 32)));
+  const uint32_t mantissa = (top >= 30) ? (x >> (top - 30)) : (x << (30 - top)); // 1 to 2 in Q2n30
+  uint8_t k = 0; // the largest power 2^(k/16) under the mantissa
+  for (uint8_t step = 8; step; step >>= 1) {
+    if (EXP2_SIXTEENTHS[k + step] <= mantissa) k += step;
+  }
+  // log2(1 + y) for y under 1/16, from the series for ln(1 + y), in Q0n32 and Q0n16
+  const uint32_t y = (uint32_t)((((uint64_t)mantissa << 32) / EXP2_SIXTEENTHS[k]) - ((uint64_t)1 << 32));
+  const uint32_t y16 = y >> 16;
+  const uint32_t y2 = y16 * y16; // Q0n32
+  const uint32_t ln = y - (y2 >> 1) + (uint32_t)(((uint64_t)y2 * y16) / 3 >> 16);
+  const uint32_t fraction = (uint32_t)(((uint64_t)ln * 94548) >> 32); // 1 / ln2 in Q1n16
+  // the integer part, less 16 after the shift, as it is negative for x under 1
+  return ((Q15n16)top << 16) - ((Q15n16)16 << 16) + ((Q15n16)k << 12) + (Q15n16)fraction;
 }
 
 
@@ -0,0 +1,160 @@
+/*
+ * mozzi_mult.h
+ *
+ * This file is part of Mozzi.
+ *
+ * Mozzi is licensed under a Creative Commons Attribution-NonCommercial-ShareAlike 4.0 International License.
+ *
+ */
+
+#ifndef MOZZI_MULT_H_
+#define MOZZI_MULT_H_
+
+#if ARDUINO >= 100
+ #include "Arduino.h"
+#else
+ #include "WProgram.h"
+#endif
+
+#include "hardware_defines.h"
+
+#if IS_AVR()
+ #include "mult16x16.h"
+#elif defined(__XTENSA__)
+ #include <xtensa/config/core-isa.h>
+#endif
+
+/** @defgroup mult Fast multiplies
+Multiplies of the sizes used in audio code, which keep only the bits that are needed, with the
+fastest way for each processor picked at compile time:
+- on AVR, the assembly from mult16x16.h,
+- on the ESP32, MULSH for the top half of a 32 x 32 multiply, instead of a call to the 64 bit
+multiply in libgcc,
+- on ARM cores with the DSP instructions (Teensy 3 and 4), SMULWB for 32 x 16,
+- elsewhere, and on the host, plain C which the compiler turns into one multiply.
+
+The widening multiplies in C, like (int64_t)a * b, are only fast when the compiler can see both
+operands are 32 bits, which it can't after they have been passed around as int64_t, so these take
+their operands at their real size.
+*/
+
+/** @ingroup mult
+Unsigned 16 x 16 bit multiply, keeping all 32 bits.
+*/
+inline
+uint32_t mult_u16x16(uint16_t a, uint16_t b)
+{
+#if IS_AVR()
+	uint32_t result;
+	MultiU16X16to32(result, a, b);
+	return result;
+#else
+	return (uint32_t)a * b;
+#endif
+}
+
+
+/** @ingroup mult
+Unsigned 16 x 16 bit multiply, keeping the top 16 bits.
+*/
+inline
+uint16_t mult_u16x16_h16(uint16_t a, uint16_t b)
+{
+#if IS_AVR()
+	uint16_t result;
+	MultiU16X16toH16(result, a, b);
+	return result;
+#else
+	return (uint16_t)(((uint32_t)a * b) >> 16);
+#endif
+}
+
+
+/** @ingroup mult
+Signed 16 x 16 bit multiply, keeping all 32 bits.
+*/
+inline
+int32_t mult_s16x16(int16_t a, int16_t b)
+{
+	// MUL16S on the ESP32, one SMULBB or MULS on ARM, __mulhisi3 on AVR
+	return (int32_t)a * b;
+}
+
+
+/** @ingroup mult
+Signed 16 x 16 bit multiply, keeping the top 16 bits.
+*/
+inline
+int16_t mult_s16x16_h16(int16_t a, int16_t b)
+{
+	return (int16_t)(((int32_t)a * b) >> 16);
+}
+
+
+/** @ingroup mult
+Signed 32 x 32 bit multiply, keeping the top 32 bits of the 64.
+*/
+inline
+int32_t mult_s32x32_h32(int32_t a, int32_t b)
+{
+#if defined(__XTENSA__) && XCHAL_HAVE_MUL32_HIGH
+	int32_t result;
+	asm ("mulsh %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+	return result;
+#else
+	return (int32_t)(((int64_t)a * b) >> 32);
+#endif
+}
+
+
+/** @ingroup mult
+Signed 32 x 32 bit multiply, shifted right, keeping 32 bits.  This is (a * b) >> SHIFT without
+the overflow of a 32 bit multiply, as long as the result fits in 32 bits.
+@tparam SHIFT from 1 to 32.
+*/
+template <uint8_t SHIFT>
+inline
+int32_t mult_s32x32_shr(int32_t a, int32_t b)
+{
+	static_assert(SHIFT >= 1 && SHIFT <= 32, "mult_s32x32_shr shifts 1 to 32 bits");
+#if defined(__XTENSA__) && XCHAL_HAVE_MUL32_HIGH
+	if (SHIFT == 32) return mult_s32x32_h32(a, b);
+	// the two halves of the product, MULL and MULSH
+	const uint32_t low = (uint32_t)a * (uint32_t)b;
+	const int32_t high = mult_s32x32_h32(a, b);
+	return (int32_t)(((uint32_t)high << ((32 - SHIFT) & 31)) | (low >> (SHIFT & 31)));
+#else
+	return (int32_t)(((int64_t)a * b) >> SHIFT);
+#endif
+}
+
+
+/** @ingroup mult
+Signed 32 x 16 bit multiply, keeping the top 32 bits of the 48.
+*/
+inline
+int32_t mult_s32x16_h32(int32_t a, int16_t b)
+{
+#if defined(__ARM_FEATURE_DSP)
+	int32_t result;
+	asm ("smulwb %0, %1, %2" : "=r" (result) : "r" (a), "r" ((int32_t)b));
+	return result;
+#elif defined(__XTENSA__) && XCHAL_HAVE_MUL32_HIGH
+	// b in the top half makes the top 32 bits of a 32 x 32 multiply the same as (a * b) >> 16
+	return mult_s32x32_h32(a, (int32_t)b * 65536);
+#else
+	return (int32_t)(((int64_t)a * b) >> 16);
+#endif
+}
+
+
+/** @ingroup mult
+Signed 32 x unsigned 16 bit multiply, keeping the top 32 bits of the 48.
+*/
+inline
+int32_t mult_s32xu16_h32(int32_t a, uint16_t b)
+{
+	return mult_s32x32_shr<16>(a, b);
+}
+
+#endif /* MOZZI_MULT_H_ */
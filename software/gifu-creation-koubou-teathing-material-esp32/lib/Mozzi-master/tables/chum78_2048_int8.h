@@ -0,0 +1,133 @@
+#ifndef CHUM78_2048_H_
+#define CHUM78_2048_H_
+ 
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+ 
+/* chum78_int8.h resampled to 2048 cells */
+#define CHUM78_2048_NUM_CELLS 2048
+ 
+CONSTTABLE_STORAGE(int8_t) CHUM78_2048_DATA [] = {-20, -17, -17, -42, -39, -33,
+-43, -49, -37, -60, -43, -25, -9, -16, -14, -12, 0, 2, 14, -9, -1, 18, 15, 6,
+29, 20, 26, 42, 27, 15, 24, 11, 21, 7, -6, -7, -8, -11, -4, -8, -14, -17, -20,
+-11, -38, -34, -27, -30, -43, -38, -56, -48, -40, -20, -11, -21, -22, -4, -3,
+15, 14, 16, 32, 36, 36, 43, 37, 34, 57, 46, 23, 32, 18, 10, 22, 5, -18, -23,
+-13, -36, -32, -41, -38, -57, -48, -54, -64, -44, -29, -43, -36, -32, -35, -32,
+-3, 9, 5, 11, 3, 20, 38, 44, 31, 42, 54, 46, 50, 51, 36, 54, 59, 38, 35, 35, 20,
+26, 14, -6, -13, -6, -22, -28, -31, -32, -38, -46, -56, -59, -60, -50, -64, -60,
+-49, -68, -69, -43, -28, -23, -8, -22, -4, 24, 32, 29, 43, 50, 56, 71, 80, 58,
+61, 81, 56, 55, 54, 33, 20, 28, 1, -9, -3, -25, -32, -37, -37, -41, -54, -53,
+-57, -60, -47, -42, -54, -26, -37, -43, -30, -10, 7, 15, 0, 7, 27, 36, 42, 52,
+55, 70, 68, 80, 68, 59, 74, 62, 54, 51, 32, 19, 26, 6, -14, -26, -44, -47, -54,
+-70, -71, -74, -81, -82, -78, -82, -60, -63, -55, -50, -53, -52, -20, -4, 12,
+-4, 2, 21, 35, 35, 51, 50, 58, 71, 68, 68, 76, 69, 74, 61, 62, 52, 32, 33, 25,
+-2, -22, -33, -50, -50, -73, -78, -76, -86, -94, -90, -97, -76, -81, -74, -51,
+-70, -70, -39, -22, 0, 8, 3, 15, 42, 46, 54, 58, 66, 80, 80, 80, 86, 74, 84, 88,
+80, 68, 46, 45, 40, 20, -10, -22, -38, -46, -70, -80, -79, -84, -98, -96, -100,
+-102, -95, -90, -78, -87, -86, -78, -50, -27, -8, -10, 1, 27, 45, 56, 68, 68,
+88, 92, 92, 100, 96, 92, 103, 98, 86, 62, 58, 52, 30, 1, -17, -36, -54, -71,
+-84, -93, -92, -108, -109, -105, -115, -113, -101, -88, -85, -82, -84, -56, -30,
+-10, 6, 6, 25, 54, 65, 77, 73, 84, 99, 93, 104, 107, 89, 97, 102, 87, 67, 69,
+52, 39, 12, -10, -29, -48, -60, -77, -89, -85, -94, -104, -95, -106, -106, -99,
+-89, -77, -76, -83, -68, -36, -18, 2, 6, 17, 42, 60, 72, 74, 79, 97, 95, 103,
+109, 101, 92, 105, 94, 82, 76, 70, 58, 42, 14, -4, -24, -42, -60, -76, -81, -87,
+-102, -101, -106, -112, -109, -100, -92, -85, -91, -88, -64, -39, -18, -2, 2,
+22, 50, 62, 72, 84, 96, 106, 109, 118, 118, 107, 115, 108, 96, 75, 75, 60, 40,
+14, -6, -26, -47, -66, -81, -91, -93, -108, -112, -107, -117, -118, -105, -97,
+-88, -87, -89, -77, -47, -27, -7, -2, 10, 38, 55, 66, 77, 86, 101, 110, 116,
+118, 111, 115, 120, 107, 91, 84, 77, 65, 40, 16, -4, -24, -45, -63, -79, -90,
+-100, -109, -110, -119, -123, -118, -104, -89, -87, -87, -84, -61, -34, -15, 1,
+6, 27, 52, 64, 76, 85, 95, 108, 116, 120, 111, 100, 114, 104, 92, 74, 71, 61,
+40, 15, -4, -24, -43, -62, -77, -91, -102, -110, -112, -116, -122, -122, -112,
+-95, -88, -85, -86, -74, -45, -25, -6, -2, 11, 38, 54, 66, 76, 83, 98, 107, 114,
+110, 104, 110, 107, 96, 82, 73, 67, 58, 32, 12, -6, -26, -43, -61, -76, -87,
+-98, -105, -108, -116, -120, -114, -98, -85, -82, -83, -80, -59, -32, -15, -2,
+3, 19, 47, 58, 68, 79, 86, 102, 108, 112, 110, 110, 116, 108, 96, 76, 77, 66,
+50, 27, 7, -12, -32, -50, -68, -81, -92, -101, -108, -114, -120, -122, -111,
+-91, -83, -81, -81, -69, -39, -20, -1, 3, 14, 40, 56, 67, 76, 84, 98, 106, 112,
+108, 102, 109, 104, 94, 74, 67, 62, 50, 31, 16, -6, -23, -34, -56, -68, -80,
+-91, -97, -104, -111, -115, -114, -99, -80, -78, -80, -74, -56, -31, -14, -3, 0,
+14, 40, 52, 62, 71, 83, 95, 102, 104, 100, 104, 110, 101, 90, 76, 75, 66, 52,
+37, 18, -2, -11, -32, -50, -63, -76, -83, -88, -100, -106, -108, -102, -82, -76,
+-74, -74, -61, -38, -17, 0, 2, 11, 34, 51, 60, 67, 72, 88, 94, 100, 95, 89, 100,
+94, 85, 71, 69, 62, 53, 40, 25, 2, -10, -24, -46, -59, -72, -82, -86, -95, -104,
+-107, -105, -92, -77, -76, -78, -72, -58, -39, -21, -14, -8, 4, 18, 38, 44, 42,
+63, 72, 75, 73, 74, 76, 86, 70, 69, 54, 48, 46, 30, 17, 13, -2, -13, -26, -41,
+-42, -54, -63, -65, -76, -84, -76, -73, -70, -52, -46, -53, -44, -22, -13, 5,
+14, 24, 26, 50, 57, 58, 66, 79, 86, 90, 80, 81, 90, 88, 78, 72, 66, 60, 48, 34,
+14, 16, 4, -20, -38, -50, -61, -72, -76, -84, -94, -98, -92, -86, -80, -60, -68,
+-70, -56, -38, -23, -20, -11, -6, 8, 26, 32, 32, 46, 57, 67, 58, 58, 54, 70, 51,
+54, 47, 43, 42, 38, 26, 6, 0, -7, -10, -16, -35, -44, -49, -42, -48, -59, -51,
+-54, -44, -36, -29, -30, -32, 1, 4, 6, 24, 32, 40, 56, 54, 52, 61, 66, 76, 64,
+52, 51, 55, 48, 44, 19, 20, 24, 9, -12, -19, -27, -24, -27, -48, -41, -41, -34,
+-28, -35, -41, -33, -29, -28, -17, -17, -19, -24, -6, 4, 13, 9, 9, 16, 25, 14,
+22, 15, 12, 30, 33, 15, 16, 36, 40, 23, 17, 24, 5, 16, 9, -13, -21, -11, -16,
+-28, -37, -39, -43, -48, -47, -49, -53, -53, -59, -50, -32, -28, -27, -15, -13,
+3, 13, 15, 12, 16, 24, 18, 6, 21, 24, 26, 30, 22, 24, 30, 32, 25, 28, 31, 24,
+19, 23, 26, 22, 20, 5, 0, 7, -1, -5, -22, -11, -4, -8, -16, -14, -17, 6, 6, -14,
+-2, -4, -6, 10, 9, -2, 5, 8, -4, -6, 10, -3, -1, -6, -5, -6, -4, -19, -6, -6, 0,
+-6, -14, -17, -5, 22, 14, -5, 0, 3, 0, 3, -4, 6, 1, 13, -6, 4, 8, 9, 0, 4, -17,
+-12, 9, -6, -2, 2, -8, -18, -8, -16, -22, -18, -22, -30, -22, -15, -32, -16, -4,
+-12, -17, -6, -16, -18, 9, 15, 6, -8, 4, 2, 12, 14, 3, 8, 30, 6, 30, 21, 8, 34,
+39, 16, 18, 17, 6, 23, 23, 1, -8, -14, -29, -26, -29, -36, -50, -48, -43, -57,
+-61, -44, -50, -47, -26, -56, -38, -10, 6, 13, 2, 4, 10, 27, 27, 30, 17, 42, 37,
+47, 56, 49, 50, 58, 39, 35, 37, 14, 15, 13, 1, -13, -19, -35, -29, -30, -50,
+-54, -54, -71, -65, -70, -69, -64, -59, -41, -46, -52, -38, -10, -2, -8, -2, -1,
+18, 18, 26, 33, 50, 58, 68, 76, 71, 61, 76, 60, 42, 57, 37, 15, 28, 19, -5, -3,
+-18, -29, -34, -39, -52, -57, -59, -58, -69, -55, -42, -47, -30, -25, -37, -25,
+-1, 14, 16, 17, 18, 30, 38, 44, 45, 62, 70, 63, 79, 72, 52, 73, 72, 38, 56, 48,
+20, 18, 27, -6, -22, -34, -46, -56, -56, -75, -69, -80, -80, -80, -84, -64, -69,
+-60, -38, -58, -53, -27, -7, 10, 8, 7, 12, 40, 38, 48, 51, 66, 65, 76, 74, 61,
+72, 69, 56, 60, 54, 28, 24, 32, -2, -14, -27, -46, -52, -60, -76, -71, -76, -88,
+-91, -88, -83, -79, -74, -56, -57, -66, -45, -27, -4, 11, 0, 4, 32, 33, 46, 50,
+53, 72, 78, 75, 78, 74, 74, 84, 83, 72, 57, 47, 46, 36, 9, -10, -28, -39, -52,
+-69, -77, -79, -92, -99, -92, -106, -100, -93, -87, -71, -82, -80, -61, -30,
+-13, -2, -10, 17, 38, 50, 61, 66, 80, 93, 90, 96, 104, 92, 98, 102, 92, 84, 72,
+53, 53, 28, 4, -16, -34, -53, -68, -82, -87, -96, -106, -100, -106, -111, -106,
+-95, -75, -84, -84, -72, -37, -18, 1, 1, 15, 42, 56, 68, 72, 75, 94, 94, 96,
+106, 98, 95, 101, 97, 86, 86, 66, 58, 44, 18, -4, -24, -42, -56, -74, -82, -88,
+-101, -100, -102, -108, -109, -96, -86, -77, -83, -80, -54, -32, -13, -1, 4, 22,
+47, 59, 68, 68, 87, 95, 91, 105, 105, 97, 101, 105, 92, 88, 81, 67, 53, 46, 19,
+-5, -22, -41, -58, -74, -76, -95, -102, -98, -112, -115, -106, -100, -87, -90,
+-94, -84, -52, -33, -13, -11, 4, 32, 47, 60, 64, 78, 92, 92, 102, 109, 101, 99,
+109, 94, 88, 86, 72, 56, 48, 28, 2, -18, -37, -56, -72, -79, -93, -104, -104,
+-108, -117, -111, -104, -94, -88, -94, -91, -70, -44, -26, -16, -8, 13, 38, 49,
+60, 69, 85, 96, 106, 112, 111, 108, 116, 115, 102, 96, 87, 77, 64, 44, 22, -2,
+-22, -42, -61, -78, -91, -103, -111, -112, -124, -125, -118, -106, -92, -93,
+-95, -81, -51, -31, -12, -6, 11, 39, 53, 65, 78, 90, 101, 110, 117, 120, 114,
+115, 119, 107, 99, 91, 81, 68, 52, 35, 10, -11, -32, -52, -69, -84, -97, -108,
+-107, -119, -124, -122, -111, -96, -90, -97, -92, -66, -42, -24, -16, -8, 11,
+36, 46, 58, 69, 83, 94, 103, 110, 114, 112, 116, 113, 104, 96, 88, 79, 67, 49,
+29, 4, -16, -34, -55, -71, -86, -98, -105, -110, -120, -124, -117, -105, -92,
+-94, -96, -84, -52, -34, -17, -12, 1, 28, 44, 55, 66, 78, 91, 101, 108, 114,
+111, 117, 114, 112, 103, 92, 85, 74, 57, 38, 12, -9, -30, -50, -68, -84, -98,
+-108, -112, -121, -127, -126, -115, -96, -87, -96, -89, -62, -38, -21, -7, -2,
+16, 41, 52, 62, 73, 84, 96, 104, 109, 108, 110, 111, 112, 105, 93, 86, 78, 67,
+54, 31, 6, -11, -30, -51, -68, -83, -95, -103, -112, -121, -125, -122, -106,
+-93, -96, -99, -85, -59, -39, -23, -19, -7, 15, 34, 44, 56, 68, 80, 91, 99, 104,
+101, 110, 110, 106, 98, 90, 83, 73, 62, 49, 22, 2, -14, -36, -54, -71, -85, -94,
+-100, -111, -117, -118, -104, -86, -76, -82, -74, -49, -27, -10, 2, 5, 19, 42,
+51, 60, 67, 78, 88, 96, 100, 92, 94, 100, 96, 92, 81, 76, 68, 59, 50, 32, 8, -2,
+-22, -42, -58, -72, -84, -90, -101, -110, -116, -110, -93, -84, -90, -91, -82,
+-62, -43, -32, -29, -19, -2, 19, 29, 40, 52, 66, 77, 87, 91, 89, 101, 102, 100,
+96, 87, 82, 75, 65, 55, 35, 18, 0, -22, -40, -56, -71, -81, -89, -101, -110,
+-111, -96, -81, -75, -80, -74, -56, -35, -18, -10, -6, 4, 25, 37, 45, 50, 63,
+74, 83, 88, 85, 87, 83, 84, 73, 58, 44, 44, 24, 11, -4, -11, -23, -39, -53, -54,
+-60, -74, -72, -76, -80, -87, -66, -68, -56, -45, -49, -44, -22, -14, -4, 4, 10,
+14, 25, 28, 35, 42, 54, 62, 66, 65, 63, 76, 68, 76, 64, 58, 52, 50, 40, 29, 12,
+0, -10, -26, -39, -58, -66, -74, -78, -89, -96, -100, -90, -92, -73, -88, -82,
+-68, -48, -45, -28, -5, -7, 5, 22, 23, 31, 45, 43, 50, 57, 68, 52, 62, 68, 51,
+56, 50, 20, 3, 12, -12, -13, -30, -42, -50, -38, -43, -58, -51, -32, -28, -28,
+-25, -8, -11, 10, 5, -1, 18, 28, 35, 46, 40, 36, 47, 52, 38, 34, 35, 31, 33, 22,
+34, 33, 40, 40, 40, 44, 43, 20, 11, 19, 11, 5, -6, -20, -18, -20, -38, -39, -38,
+-32, -53, -58, -58, -51, -52, -46, -48, -50, -38, -20, -21, -22, -10, 8, 8, 23,
+20, 24, 43, 34, 50, 53, 41, 57, 54, 44, 42, 44, 26, 20, 10, 7, 1, -20, -26, -29,
+-42, -45, -55, -47, -35, -47, -50, -38, -32, -22, -12, -23, -23, -4, -4, -2, 4,
+2, 21, 26, 34, 26, 23, 37, 28, 22, 34, 15, 14, 22, 12, -3, 14, 13, -2,
+ }; 
+ 
+ #endif /* CHUM78_2048_H_ */
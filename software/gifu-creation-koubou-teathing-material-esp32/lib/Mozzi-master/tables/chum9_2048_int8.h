@@ -0,0 +1,129 @@
+#ifndef CHUM9_2048_H_
+#define CHUM9_2048_H_
+ 
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+ 
+/* chum9_int8.h resampled to 2048 cells */
+#define CHUM9_2048_NUM_CELLS 2048
+ 
+CONSTTABLE_STORAGE(int8_t) CHUM9_2048_DATA [] = {38, 40, -24, -55, -58, -57,
+-56, -55, -53, -54, -51, -50, -49, 1, 48, 52, 54, 52, 51, 50, 47, 48, 44, 48,
+46, 46, 47, 41, -33, -55, -47, -49, -48, -46, -46, -46, -43, -42, -42, -39, -38,
+-37, -30, 71, 56, 56, 57, 55, 54, 51, 50, 50, 45, 42, -66, -51, -52, -51, -49,
+-50, -49, -47, -49, -48, -46, -47, -46, -45, -45, 56, 47, 46, 49, 48, 45, 46,
+44, 40, 40, 38, 37, 39, 2, -53, -56, -52, -51, -51, -50, -49, -49, -46, -44,
+-43, 65, 46, 51, 50, 47, 46, 43, 44, 46, 44, 45, 45, 43, 43, 36, -66, -44, -45,
+-46, -43, -43, -40, -40, -36, -38, -36, -35, -36, -43, 52, 51, 51, 50, 47, 48,
+46, 45, 43, 44, 45, -20, -48, -52, -51, -44, -45, -41, -41, -41, -42, -41, -41,
+-42, -39, -42, 11, 41, 44, 44, 38, 38, 38, 35, 38, 38, 35, 32, 34, 33, -56, -49,
+-47, -46, -45, -45, -44, -41, -43, -42, -41, 42, 51, 50, 52, 40, 41, 42, 39, 39,
+40, 39, 38, 38, 39, 38, 0, -40, -44, -42, -39, -38, -38, -39, -38, -36, -35,
+-34, -32, -34, 21, 51, 46, 48, 48, 49, 46, 42, 41, 39, 39, 27, -60, -50, -48,
+-38, -40, -38, -40, -38, -36, -38, -34, -33, -34, -35, -47, 50, 38, 42, 42, 38,
+36, 34, 35, 32, 34, 32, 33, 32, -42, -46, -43, -45, -44, -42, -43, -42, -39,
+-37, -35, 10, 46, 49, 50, 42, 38, 38, 37, 35, 34, 32, 31, 30, 34, 34, 38, -16,
+-42, -42, -39, -37, -36, -36, -36, -33, -28, -30, -30, -34, -24, 52, 44, 45, 42,
+43, 40, 37, 40, 38, 35, 20, -58, -50, -50, -34, -34, -34, -32, -32, -30, -31,
+-31, -30, -33, -33, -49, 9, 32, 34, 34, 33, 32, 32, 32, 32, 28, 27, 26, 22, -28,
+-47, -41, -43, -42, -39, -36, -35, -36, -37, -34, -9, 51, 50, 50, 40, 33, 32,
+29, 30, 30, 31, 31, 30, 32, 30, 42, 24, -40, -36, -37, -36, -34, -30, -29, -28,
+-28, -26, -26, -25, -41, 30, 42, 42, 41, 41, 40, 37, 35, 34, 35, 17, -52, -49,
+-47, -32, -30, -30, -29, -28, -30, -28, -28, -30, -31, -28, -40, -46, 28, 35,
+34, 32, 30, 31, 28, 27, 25, 26, 23, 23, -56, -36, -40, -38, -36, -36, -34, -34,
+-32, -33, -32, -34, 46, 49, 48, 46, 25, 27, 26, 26, 25, 26, 24, 26, 26, 24, 36,
+33, -46, -31, -31, -30, -30, -28, -28, -26, -24, -22, -23, -21, -32, 20, 36, 36,
+36, 34, 33, 32, 34, 31, 31, 23, -55, -46, -48, -33, -25, -23, -25, -24, -24,
+-24, -24, -26, -24, -24, -28, -50, -2, 26, 30, 28, 26, 27, 24, 21, 22, 21, 20,
+24, -65, -36, -32, -31, -33, -31, -32, -32, -28, -30, -30, -29, 25, 49, 46, 46,
+27, 22, 22, 21, 21, 21, 22, 22, 22, 20, 23, 48, -6, -29, -27, -27, -24, -24,
+-23, -22, -23, -20, -19, -19, -18, 39, 26, 30, 29, 32, 30, 30, 28, 29, 28, 25,
+-30, -46, -48, -42, -16, -20, -19, -20, -18, -19, -18, -19, -20, -21, -17, -36,
+4, 26, 25, 21, 22, 20, 20, 19, 17, 18, 16, 18, -50, -51, -23, -28, -27, -27,
+-26, -25, -26, -25, -24, -21, 26, 48, 48, 46, 28, 18, 17, 17, 15, 14, 16, 16,
+17, 17, 18, 36, 40, -32, -24, -23, -24, -22, -20, -19, -17, -18, -16, -18, 31,
+35, 25, 26, 25, 25, 24, 24, 25, 25, 23, 23, -10, -42, -45, -45, -26, -16, -15,
+-14, -14, -14, -14, -14, -15, -14, -15, -34, 21, 22, 22, 21, 19, 19, 18, 17, 17,
+17, 16, 14, -49, -54, -33, -24, -23, -22, -19, -22, -22, -22, -18, -18, 11, 45,
+50, 47, 24, 14, 13, 12, 9, 10, 10, 13, 12, 12, 10, 17, 46, -24, -21, -20, -20,
+-20, -16, -16, -16, -16, -13, -10, 34, 48, 15, 19, 16, 20, 18, 21, 22, 20, 19,
+17, -11, -42, -45, -46, -44, -8, -11, -10, -8, -10, -10, -9, -11, -10, -9, -18,
+6, 20, 17, 18, 17, 15, 13, 12, 12, 12, 11, -2, -57, -52, -54, -17, -18, -18,
+-17, -15, -16, -17, -14, -16, -17, 48, 48, 47, 25, 10, 11, 8, 8, 8, 8, 9, 9, 8,
+8, 7, 42, -25, -14, -17, -16, -14, -14, -12, -11, -10, -11, -6, 58, 54, 28, 16,
+16, 14, 16, 14, 14, 16, 14, 12, -10, -46, -47, -47, -48, -6, -6, -5, -7, -6, -6,
+-6, -4, -5, -6, -10, -1, 7, 12, 12, 12, 10, 13, 12, 8, 7, 8, -28, -49, -51, -51,
+-25, -14, -12, -12, -11, -10, -12, -12, -10, -10, 26, 46, 44, 35, 4, 3, 4, 4, 4,
+4, 6, 3, 6, 4, 6, 35, -4, -14, -14, -13, -12, -12, -11, -10, -9, -8, 30, 52, 51,
+51, 19, 8, 9, 10, 8, 11, 10, 10, 11, 10, -56, -45, -43, -42, -14, -3, -4, -2,
+-2, -2, 0, -2, -3, -2, -2, -1, 16, 10, 11, 11, 11, 10, 8, 8, 8, 5, -38, -51,
+-50, -50, -44, -2, -8, -5, -6, -7, -7, -8, -8, -7, 4, 49, 46, 46, -2, 1, 2, 2,
+0, 0, 1, 0, -1, 0, 0, 24, -1, -11, -8, -10, -7, -7, -6, -7, -6, -4, -5, 58, 49,
+50, 48, 0, 5, 5, 6, 4, 8, 3, 4, 4, -34, -48, -44, -43, -25, 2, 3, 2, 2, 2, 0, 3,
+1, 3, 3, 6, 11, 9, 7, 6, 8, 6, 5, 4, 2, 2, -36, -51, -51, -50, -48, -17, -3, -2,
+-4, -3, -2, -2, -3, -3, -4, 38, 48, 46, -1, -4, -3, -4, -5, -4, -4, -2, -3, -5,
+-5, -6, 12, -7, -5, -4, -4, -3, -2, -4, -2, -1, -1, 57, 48, 48, 50, 18, 3, 0,
+-1, 2, 2, -1, 0, 2, -10, -49, -44, -44, -41, 1, 8, 6, 9, 6, 4, 7, 5, 6, 5, 5,
+-2, 4, 4, 2, 0, 1, 1, 2, 1, 1, 0, -56, -46, -48, -48, -48, 13, 1, 2, 2, 0, -1,
+0, 0, 0, 16, 45, 46, -2, -8, -7, -8, -7, -8, -8, -8, -6, -8, -8, -7, 16, -2, -2,
+-1, -1, -1, 0, -1, 1, 1, 3, 40, 51, 48, 48, 48, -12, -6, -3, -5, -5, -3, -3, -3,
+-2, -34, -47, -45, -44, -3, 11, 10, 11, 10, 9, 9, 11, 12, 11, 11, -8, 0, -1, -1,
+0, 0, -2, -1, -3, -2, -3, -33, -44, -49, -48, -50, -11, 7, 6, 7, 5, 5, 5, 5, 4,
+2, 50, 43, -2, -13, -12, -10, -12, -12, -11, -10, -10, -10, -10, -11, 26, 5, 3,
+4, 4, 2, 4, 4, 4, 5, 4, 35, 46, 46, 47, 47, -12, -9, -9, -10, -9, -7, -7, -7,
+-5, -8, -50, -45, -42, -4, 16, 13, 16, 14, 11, 14, 14, 12, 12, 11, -24, 0, -4,
+-4, -6, -5, -5, -6, -8, -10, -7, -10, -56, -48, -46, -47, -15, 10, 11, 9, 10,
+10, 8, 8, 6, 4, 31, 43, -2, -17, -15, -16, -16, -16, -14, -16, -14, -13, -13,
+-15, 8, 13, 6, 6, 6, 6, 8, 7, 6, 10, 10, 13, 50, 46, 47, 47, 10, -10, -14, -14,
+-14, -13, -12, -10, -11, -12, -36, -46, -46, 17, 19, 19, 19, 18, 18, 19, 18, 18,
+18, 16, -12, -14, -8, -8, -9, -8, -10, -10, -8, -10, -10, -11, -38, -48, -46,
+-48, -12, 12, 15, 15, 14, 12, 13, 12, 12, 12, 11, 39, -1, -17, -18, -21, -20,
+-19, -19, -16, -18, -16, -20, -18, -4, 25, 11, 10, 11, 13, 10, 14, 11, 12, 10,
+12, 41, 47, 46, 45, 43, -29, -18, -18, -18, -18, -16, -16, -16, -13, -15, -50,
+-28, 25, 22, 22, 24, 21, 20, 20, 20, 21, 22, 19, 17, -40, -14, -11, -14, -13,
+-12, -12, -12, -14, -12, -12, -31, -43, -46, -45, 4, 24, 19, 21, 19, 17, 20, 16,
+17, 15, 14, 27, -10, -25, -23, -21, -23, -22, -20, -21, -23, -22, -22, -23, -25,
+39, 16, 16, 18, 14, 16, 16, 14, 16, 14, 16, 36, 46, 44, 45, 46, -20, -22, -27,
+-26, -22, -22, -19, -18, -18, -18, -27, 0, 24, 22, 24, 24, 22, 24, 22, 24, 21,
+21, 23, 24, -40, -15, -18, -18, -16, -18, -16, -17, -17, -14, -15, -14, -49,
+-44, -47, 0, 28, 24, 24, 25, 22, 21, 22, 20, 18, 21, 24, -40, -21, -26, -24,
+-26, -24, -24, -24, -24, -24, -24, -24, -25, 13, 14, 18, 20, 18, 18, 20, 18, 18,
+16, 18, 27, 46, 44, 44, 42, -10, -26, -25, -27, -26, -25, -24, -23, -22, -19,
+-22, 42, 22, 25, 24, 27, 28, 26, 25, 27, 26, 26, 25, 22, -36, -26, -21, -21,
+-20, -22, -20, -21, -19, -21, -19, -19, -34, -42, -41, -14, 28, 28, 30, 28, 28,
+26, 25, 26, 24, 24, 22, -54, -25, -27, -25, -28, -28, -27, -28, -29, -29, -26,
+-30, -27, -19, 29, 26, 26, 26, 22, 19, 22, 21, 20, 20, 22, 44, 44, 47, 42, -19,
+-34, -32, -32, -31, -32, -28, -28, -28, -27, -4, 55, 26, 30, 28, 28, 29, 28, 29,
+28, 30, 29, 31, 26, -25, -37, -28, -24, -24, -26, -26, -24, -24, -24, -22, -22,
+-33, -43, -42, -8, 32, 35, 34, 31, 32, 33, 32, 30, 28, 28, -14, -47, -38, -31,
+-31, -32, -30, -31, -32, -30, -32, -30, -30, -30, -32, 32, 26, 30, 28, 26, 27,
+26, 28, 26, 27, 25, 35, 41, 40, 37, -13, -36, -40, -38, -36, -36, -35, -33, -34,
+-29, -29, 42, 45, 33, 32, 35, 36, 34, 36, 34, 31, 34, 32, 32, 0, -43, -28, -30,
+-29, -30, -28, -27, -26, -28, -26, -24, -35, -39, -40, -42, 53, 40, 41, 38, 38,
+36, 35, 34, 33, 32, 32, -66, -44, -37, -36, -35, -34, -34, -34, -35, -33, -32,
+-36, -34, -34, -8, 29, 32, 30, 33, 30, 27, 27, 27, 28, 27, 38, 40, 38, 42, 4,
+-40, -42, -40, -40, -36, -38, -38, -36, -34, -32, 22, 49, 35, 38, 38, 37, 37,
+36, 34, 37, 36, 37, 36, 37, -45, -31, -34, -32, -32, -30, -30, -33, -32, -34,
+-31, -37, -43, -39, -37, 19, 45, 42, 45, 42, 42, 40, 37, 36, 37, 34, -32, -56,
+-44, -40, -39, -40, -40, -39, -38, -38, -37, -38, -37, -42, -40, 47, 37, 36, 36,
+35, 36, 34, 32, 33, 30, 29, 43, 40, 41, 43, -61, -46, -46, -46, -43, -44, -44,
+-41, -38, -35, 26, 53, 39, 42, 43, 42, 42, 40, 39, 40, 40, 40, 41, 38, 28, -54,
+-39, -41, -39, -37, -38, -36, -34, -34, -32, -37, -41, -42, -40, 17, 50, 48, 49,
+45, 45, 46, 43, 45, 39, 36, 36, -70, -48, -43, -48, -44, -43, -42, -42, -41,
+-40, -44, -40, -44, -43, 16, 42, 40, 42, 40, 38, 40, 38, 38, 38, 35, 40, 42, 38,
+40, -21, -46, -48, -51, -48, -50, -46, -46, -44, -42, 2, 51, 46, 44, 47, 44, 43,
+44, 44, 44, 42, 44, 44, 42, 46, -26, -45, -42, -43, -39, -39, -41, -40, -39,
+-37, -36, -40, -42, -40, -43, 68, 48, 53, 52, 50, 48, 48, 48, 47, 43, 42, -22,
+-50, -46, -46, -48, -45, -47, -47, -47, -44, -43, -47, -48, -48, -49, 62, 44,
+44, 43, 44, 40, 41, 42, 39, 42, 42, 43, 42, 42, -13, -52, -56, -57, -52, -52,
+-50, -52, -49, -46, -46, 35, 51, 48, 50, 50, 51, 46, 50, 47, 47, 50, 46, 46, 44,
+6, -48, -47, -50, -45, -47, -45, -42, -42, -42, -42, -41, -41, -41, -41, 21, 52,
+54, 57, 55, 54, 53, 51, 50, 48, 48, -4, -47, -52, -52, -52, -51, -52, -50, -50,
+-49, -48, -48, -48, -47, -47, 11, 48, 50, 50, 50, 49, 46, 45, 44, 43, 44, 41,
+ }; 
+ 
+ #endif /* CHUM9_2048_H_ */
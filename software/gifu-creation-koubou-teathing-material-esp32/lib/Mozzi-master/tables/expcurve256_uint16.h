@@ -0,0 +1,40 @@
+#ifndef EXPCURVE256_H_
+#define EXPCURVE256_H_
+ 
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+ 
+/* (1 - exp(-4.0x)) / (1 - exp(-4.0)), x = 0 to 1, plus one guard cell */
+#define EXPCURVE256_NUM_CELLS 256
+ 
+CONSTTABLE_STORAGE(uint16_t) EXPCURVE256_DATA [] = {0, 1035, 2054, 3057, 4045,
+5017, 5974, 6916, 7844, 8758, 9657, 10542, 11414, 12272, 13116, 13948, 14767,
+15573, 16366, 17148, 17917, 18674, 19419, 20153, 20876, 21587, 22287, 22977,
+23656, 24324, 24982, 25629, 26267, 26895, 27513, 28121, 28720, 29310, 29891,
+30462, 31025, 31579, 32124, 32661, 33190, 33710, 34223, 34727, 35224, 35712,
+36194, 36668, 37134, 37593, 38046, 38491, 38929, 39360, 39785, 40203, 40615,
+41020, 41419, 41812, 42199, 42580, 42955, 43324, 43687, 44045, 44397, 44743,
+45085, 45421, 45751, 46077, 46398, 46713, 47024, 47330, 47631, 47928, 48220,
+48507, 48790, 49069, 49343, 49613, 49879, 50140, 50398, 50652, 50901, 51147,
+51389, 51627, 51862, 52093, 52320, 52544, 52765, 52981, 53195, 53405, 53612,
+53816, 54017, 54214, 54409, 54600, 54789, 54974, 55157, 55337, 55514, 55688,
+55860, 56029, 56195, 56359, 56520, 56679, 56835, 56989, 57140, 57289, 57436,
+57581, 57723, 57863, 58001, 58137, 58270, 58402, 58532, 58659, 58785, 58908,
+59030, 59150, 59268, 59384, 59498, 59611, 59721, 59831, 59938, 60044, 60148,
+60250, 60351, 60450, 60548, 60645, 60739, 60833, 60924, 61015, 61104, 61192,
+61278, 61363, 61446, 61529, 61610, 61690, 61768, 61846, 61922, 61997, 62071,
+62143, 62215, 62285, 62355, 62423, 62490, 62556, 62621, 62685, 62749, 62811,
+62872, 62932, 62991, 63050, 63107, 63164, 63220, 63275, 63329, 63382, 63434,
+63486, 63536, 63586, 63635, 63684, 63731, 63778, 63825, 63870, 63915, 63959,
+64002, 64045, 64087, 64128, 64169, 64209, 64249, 64288, 64326, 64364, 64401,
+64437, 64473, 64509, 64544, 64578, 64612, 64645, 64678, 64710, 64742, 64773,
+64804, 64834, 64864, 64893, 64922, 64951, 64979, 65006, 65033, 65060, 65086,
+65112, 65138, 65163, 65188, 65212, 65236, 65260, 65283, 65306, 65328, 65350,
+65372, 65394, 65415, 65436, 65456, 65476, 65496, 65516, 65535,
+ }; 
+ 
+ #endif /* EXPCURVE256_H_ */
@@ -0,0 +1,40 @@
+#ifndef ONEPOLE256_H_
+#define ONEPOLE256_H_
+ 
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+ 
+/* 1 - exp(-2 * pi * x) in Q0n16, x = f / fs = 0 to 1/4, plus one guard cell */
+#define ONEPOLE256_NUM_CELLS 256
+ 
+CONSTTABLE_STORAGE(uint16_t) ONEPOLE256_DATA [] = {0, 401, 799, 1195, 1589,
+1980, 2369, 2755, 3139, 3521, 3900, 4277, 4652, 5024, 5395, 5763, 6128, 6492,
+6853, 7212, 7568, 7923, 8275, 8626, 8974, 9320, 9664, 10005, 10345, 10683,
+11018, 11352, 11683, 12013, 12340, 12665, 12989, 13310, 13630, 13947, 14263,
+14577, 14888, 15198, 15506, 15812, 16116, 16418, 16719, 17018, 17314, 17609,
+17902, 18194, 18483, 18771, 19057, 19342, 19624, 19905, 20184, 20462, 20737,
+21011, 21284, 21554, 21823, 22091, 22357, 22621, 22883, 23144, 23403, 23661,
+23917, 24172, 24425, 24676, 24926, 25175, 25422, 25667, 25911, 26153, 26394,
+26634, 26872, 27108, 27343, 27577, 27809, 28040, 28269, 28497, 28724, 28949,
+29173, 29395, 29616, 29836, 30054, 30271, 30487, 30701, 30914, 31126, 31337,
+31546, 31754, 31960, 32166, 32370, 32573, 32774, 32975, 33174, 33372, 33569,
+33764, 33959, 34152, 34344, 34535, 34724, 34913, 35100, 35286, 35471, 35655,
+35838, 36020, 36200, 36380, 36558, 36735, 36911, 37086, 37260, 37433, 37605,
+37776, 37946, 38115, 38282, 38449, 38615, 38780, 38943, 39106, 39268, 39428,
+39588, 39747, 39904, 40061, 40217, 40372, 40526, 40679, 40831, 40982, 41132,
+41281, 41430, 41577, 41724, 41869, 42014, 42158, 42301, 42443, 42584, 42725,
+42864, 43003, 43141, 43278, 43414, 43549, 43684, 43818, 43950, 44082, 44214,
+44344, 44474, 44603, 44731, 44858, 44984, 45110, 45235, 45359, 45483, 45605,
+45727, 45848, 45969, 46088, 46207, 46326, 46443, 46560, 46676, 46791, 46906,
+47020, 47133, 47246, 47358, 47469, 47579, 47689, 47798, 47907, 48015, 48122,
+48228, 48334, 48439, 48544, 48648, 48751, 48854, 48956, 49057, 49158, 49258,
+49358, 49457, 49555, 49653, 49750, 49847, 49943, 50038, 50133, 50227, 50321,
+50414, 50506, 50598, 50690, 50780, 50871, 50960, 51050, 51138, 51226, 51314,
+51401, 51487, 51573, 51659, 51743, 51828, 51912,
+ }; 
+ 
+ #endif /* ONEPOLE256_H_ */
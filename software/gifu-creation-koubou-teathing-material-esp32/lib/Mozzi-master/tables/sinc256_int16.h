@@ -0,0 +1,37 @@
+#ifndef SINC256_H_
+#define SINC256_H_
+ 
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+ 
+/* windowed sinc in Q0n15, x = 0 to 4 samples, cutoff 0.9 of Nyquist, plus one guard cell */
+#define SINC256_NUM_CELLS 256
+ 
+CONSTTABLE_STORAGE(int16_t) SINC256_DATA [] = {29490, 29479, 29447, 29393,
+29317, 29221, 29102, 28963, 28803, 28622, 28421, 28200, 27959, 27699, 27420,
+27123, 26807, 26473, 26123, 25755, 25372, 24973, 24559, 24131, 23689, 23234,
+22767, 22287, 21797, 21296, 20785, 20266, 19738, 19202, 18660, 18112, 17558,
+16999, 16437, 15872, 15304, 14734, 14164, 13593, 13023, 12454, 11887, 11323,
+10761, 10204, 9651, 9104, 8562, 8027, 7498, 6977, 6464, 5960, 5465, 4979, 4504,
+4039, 3584, 3141, 2710, 2290, 1882, 1488, 1105, 736, 380, 37, -292, -608, -909,
+-1197, -1472, -1732, -1978, -2211, -2429, -2634, -2825, -3003, -3167, -3318,
+-3456, -3580, -3693, -3792, -3879, -3955, -4018, -4071, -4112, -4142, -4162,
+-4171, -4171, -4161, -4143, -4115, -4079, -4036, -3984, -3926, -3861, -3789,
+-3711, -3628, -3539, -3446, -3348, -3246, -3141, -3032, -2921, -2806, -2690,
+-2572, -2452, -2331, -2210, -2088, -1966, -1843, -1722, -1601, -1480, -1361,
+-1244, -1128, -1014, -902, -793, -686, -582, -480, -381, -286, -193, -104, -19,
+64, 142, 217, 289, 356, 420, 481, 537, 590, 639, 684, 726, 764, 799, 830, 857,
+881, 902, 920, 934, 946, 954, 960, 963, 963, 961, 956, 950, 941, 929, 916, 902,
+885, 867, 848, 827, 805, 782, 758, 733, 707, 681, 654, 627, 600, 572, 544, 516,
+488, 460, 433, 405, 378, 352, 326, 300, 275, 250, 227, 204, 181, 160, 139, 119,
+100, 82, 65, 48, 33, 18, 4, -8, -20, -32, -42, -51, -60, -68, -75, -81, -86,
+-91, -95, -98, -101, -103, -105, -106, -106, -106, -106, -105, -104, -102, -100,
+-98, -95, -93, -90, -87, -83, -80, -76, -73, -69, -65, -62, -58, -54, -51, -47,
+-44, -40, 0,
+ }; 
+ 
+ #endif /* SINC256_H_ */
@@ -0,0 +1,40 @@
+#ifndef SVFCOEFF256_H_
+#define SVFCOEFF256_H_
+ 
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+ 
+/* 2 * sin(pi * x) in Q1n15, x = f / fs = 0 to 1/4, plus one guard cell */
+#define SVFCOEFF256_NUM_CELLS 256
+ 
+CONSTTABLE_STORAGE(uint16_t) SVFCOEFF256_DATA [] = {0, 201, 402, 603, 804, 1005,
+1206, 1407, 1608, 1809, 2010, 2211, 2412, 2613, 2814, 3015, 3216, 3417, 3617,
+3818, 4019, 4219, 4420, 4621, 4821, 5022, 5222, 5422, 5623, 5823, 6023, 6224,
+6424, 6624, 6824, 7024, 7224, 7423, 7623, 7823, 8022, 8222, 8421, 8621, 8820,
+9019, 9218, 9417, 9616, 9815, 10014, 10212, 10411, 10609, 10808, 11006, 11204,
+11402, 11600, 11798, 11996, 12193, 12391, 12588, 12785, 12983, 13180, 13376,
+13573, 13770, 13966, 14163, 14359, 14555, 14751, 14947, 15143, 15338, 15534,
+15729, 15924, 16119, 16314, 16508, 16703, 16897, 17091, 17285, 17479, 17673,
+17867, 18060, 18253, 18446, 18639, 18832, 19024, 19216, 19409, 19600, 19792,
+19984, 20175, 20366, 20557, 20748, 20939, 21129, 21320, 21510, 21699, 21889,
+22078, 22268, 22457, 22645, 22834, 23022, 23210, 23398, 23586, 23774, 23961,
+24148, 24335, 24521, 24708, 24894, 25080, 25265, 25451, 25636, 25821, 26005,
+26190, 26374, 26558, 26742, 26925, 27108, 27291, 27474, 27656, 27838, 28020,
+28202, 28383, 28564, 28745, 28926, 29106, 29286, 29466, 29645, 29824, 30003,
+30182, 30360, 30538, 30716, 30893, 31071, 31248, 31424, 31600, 31776, 31952,
+32127, 32303, 32477, 32652, 32826, 33000, 33173, 33347, 33520, 33692, 33865,
+34037, 34208, 34380, 34551, 34721, 34892, 35062, 35231, 35401, 35570, 35738,
+35907, 36075, 36243, 36410, 36577, 36744, 36910, 37076, 37241, 37407, 37572,
+37736, 37900, 38064, 38228, 38391, 38554, 38716, 38878, 39040, 39201, 39362,
+39523, 39683, 39843, 40002, 40161, 40320, 40478, 40636, 40794, 40951, 41108,
+41264, 41420, 41576, 41731, 41886, 42040, 42194, 42348, 42501, 42654, 42806,
+42958, 43110, 43261, 43412, 43562, 43713, 43862, 44011, 44160, 44308, 44456,
+44604, 44751, 44898, 45044, 45190, 45335, 45480, 45625, 45769, 45912, 46056,
+46199, 46341,
+ }; 
+ 
+ #endif /* SVFCOEFF256_H_ */
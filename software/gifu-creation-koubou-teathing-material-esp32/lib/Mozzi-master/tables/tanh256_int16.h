@@ -0,0 +1,41 @@
+#ifndef TANH256_H_
+#define TANH256_H_
+ 
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+#include "mozzi_pgmspace.h"
+ 
+/* tanh(x) in Q0n15, x = -4 to 4, plus one guard cell */
+#define TANH256_NUM_CELLS 256
+ 
+CONSTTABLE_STORAGE(int16_t) TANH256_DATA [] = {-32745, -32744, -32742, -32740,
+-32739, -32737, -32735, -32733, -32731, -32728, -32726, -32723, -32720, -32717,
+-32714, -32711, -32707, -32703, -32699, -32695, -32690, -32685, -32680, -32675,
+-32669, -32662, -32656, -32648, -32641, -32633, -32624, -32615, -32605, -32595,
+-32583, -32572, -32559, -32546, -32531, -32516, -32500, -32483, -32465, -32446,
+-32425, -32403, -32380, -32355, -32328, -32300, -32270, -32239, -32205, -32169,
+-32131, -32090, -32047, -32001, -31952, -31900, -31845, -31787, -31725, -31658,
+-31588, -31514, -31435, -31350, -31261, -31166, -31066, -30959, -30846, -30726,
+-30599, -30464, -30321, -30169, -30009, -29839, -29659, -29469, -29267, -29054,
+-28829, -28592, -28340, -28075, -27796, -27501, -27190, -26863, -26518, -26156,
+-25775, -25375, -24955, -24515, -24053, -23570, -23065, -22537, -21986, -21411,
+-20812, -20189, -19541, -18869, -18173, -17451, -16706, -15936, -15142, -14325,
+-13486, -12625, -11742, -10840, -9919, -8980, -8025, -7056, -6073, -5079, -4075,
+-3063, -2045, -1024, 0, 1024, 2045, 3063, 4075, 5079, 6073, 7056, 8025, 8980,
+9919, 10840, 11742, 12625, 13486, 14325, 15142, 15936, 16706, 17451, 18173,
+18869, 19541, 20189, 20812, 21411, 21986, 22537, 23065, 23570, 24053, 24515,
+24955, 25375, 25775, 26156, 26518, 26863, 27190, 27501, 27796, 28075, 28340,
+28592, 28829, 29054, 29267, 29469, 29659, 29839, 30009, 30169, 30321, 30464,
+30599, 30726, 30846, 30959, 31066, 31166, 31261, 31350, 31435, 31514, 31588,
+31658, 31725, 31787, 31845, 31900, 31952, 32001, 32047, 32090, 32131, 32169,
+32205, 32239, 32270, 32300, 32328, 32355, 32380, 32403, 32425, 32446, 32465,
+32483, 32500, 32516, 32531, 32546, 32559, 32572, 32583, 32595, 32605, 32615,
+32624, 32633, 32641, 32648, 32656, 32662, 32669, 32675, 32680, 32685, 32690,
+32695, 32699, 32703, 32707, 32711, 32714, 32717, 32720, 32723, 32726, 32728,
+32731, 32733, 32735, 32737, 32739, 32740, 32742, 32744, 32745,
+ }; 
+ 
+ #endif /* TANH256_H_ */
@@ -0,0 +1,110 @@
+/**
+ * @file BootSequence.h
+ * @brief staged boot with per-stage timing
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+
+#pragma once
+#ifndef BOOTSEQUENCE_H
+#define BOOTSEQUENCE_H
+#include <Arduino.h>
+#include "SerialUtility.h"
+
+namespace gifu_creation_koubou_2022_synth {
+
+// Audio is brought up first, the other peripherals follow without blocking it.
+// Each stage records when it started and finished (in micros() since begin()),
+// and report() prints the timings once every stage is done.
+class BootSequence {
+ public:
+  enum Stage {
+    kStageAudio,
+    kStageIo,
+    kStagePresets,
+    kStageTouch,
+    kStageAudioPlayer,
+    kNumStages,
+  };
+
+  void begin() {
+    boot_start_ = micros();
+  }
+
+  void startStage(const Stage stage) {
+    start_[stage] = micros() - boot_start_;
+  }
+
+  // may be called from another task (audio player bring-up)
+  void finishStage(const Stage stage, const bool ok) {
+    finish_[stage] = micros() - boot_start_;
+    ok_[stage] = ok;
+    finished_[stage] = true;
+  }
+
+  bool isFinished(const Stage stage) const {
+    return finished_[stage];
+  }
+
+  bool isOk(const Stage stage) const {
+    return finished_[stage] && ok_[stage];
+  }
+
+  bool allFinished() const {
+    for (auto i = 0; i < kNumStages; ++i) {
+      if (!finished_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // call it from updateControl, prints only once
+  void reportIfFinished() {
+    if (reported_ || !allFinished()) {
+      return;
+    }
+    reported_ = true;
+
+    for (auto i = 0; i < kNumStages; ++i) {
+      p("boot: %-12s %s start %6lu us, took %6lu us\n",
+        stageName((Stage)i),
+        ok_[i] ? "ok  " : "FAIL",
+        (unsigned long)start_[i],
+        (unsigned long)(finish_[i] - start_[i]));
+    }
+  }
+
+ protected:
+  static const char* stageName(const Stage stage) {
+    switch (stage) {
+      case kStageAudio:
+        return "audio";
+      case kStageIo:
+        return "io";
+      case kStagePresets:
+        return "presets";
+      case kStageTouch:
+        return "touch";
+      case kStageAudioPlayer:
+        return "audio player";
+      default:
+        return "?";
+    }
+  }
+
+  uint32_t boot_start_ = 0;
+  // the audio player stage is timed from its boot task on core 0, and read on the loop task
+  volatile uint32_t start_[kNumStages] = {};
+  volatile uint32_t finish_[kNumStages] = {};
+  volatile bool ok_[kNumStages] = {};
+  volatile bool finished_[kNumStages] = {};
+  bool reported_ = false;
+};
+
+}  // namespace gifu_creation_koubou_2022_synth
+
+#endif  // BOOTSEQUENCE_H
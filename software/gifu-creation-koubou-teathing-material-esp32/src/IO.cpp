@@ -61,12 +61,10 @@ Io::Io() {}
 void Io::setup() {
   p("Io::setup()");
   // initialize mcp
-  if (!mcp.begin_I2C()) {
+  mcp_present = mcp.begin_I2C();
+  if (!mcp_present) {
+    // keep running without switches, patch points and leds
     Serial.println("MCP23X17 not found");
-    while (true) {
-      delay(1000);
-      Serial.println("MCP23X17 not found");
-    }
   } else {
     Serial.println("MCP23X17 found");
   }
@@ -79,6 +77,13 @@ void Io::setup() {
     bouncers[i].setPressedState(LOW);
   }
 
+  // set touch cycles here, the average value is taken by calibrateTouch()
+  touchSetCycles(0x1000 >> 5, 0x1000 >> 1);
+
+  if (!mcp_present) {
+    return;
+  }
+
   // initialize mcp
   for (auto i = 0; i < kNumMCPOutput; ++i) {
     mcp.pinMode(i + 8, OUTPUT);
@@ -108,25 +113,36 @@ void Io::setup() {
       }
     }
   }
+}
 
-  // set average value to touch pins
-  touchSetCycles(0x1000 >> 5, 0x1000 >> 1);
-  auto averageInput = [&](const uint8_t touch_pin) -> int {
-    auto sum = 0;
-    auto loop_times = 100;
-    for (auto i = 0; i < loop_times; ++i) {
-      sum += touchRead((int)touch_pin);
-    }
-    return sum / loop_times;
-  };
-  touch_average[(int)TouchPinId::kTouch0] = averageInput(touch_pins[(int)TouchPinId::kTouch0]);
-  touch_average[(int)TouchPinId::kTouch1] = averageInput(touch_pins[(int)TouchPinId::kTouch1]);
+bool Io::calibrateTouch() {
+  if (touch_calibrated) {
+    return true;
+  }
+
+  // one read per pin per call, so the calibration never blocks the audio
+  for (auto i = 0; i < (int)TouchPinId::kNumTouch; ++i) {
+    touch_sum[i] += touchRead((int)touch_pins[i]);
+  }
+  touch_calibration_count++;
+  if (touch_calibration_count < kNumTouchCalibrationReads) {
+    return false;
+  }
+
+  for (auto i = 0; i < (int)TouchPinId::kNumTouch; ++i) {
+    touch_average[i] = touch_sum[i] / kNumTouchCalibrationReads;
+  }
+  touch_calibrated = true;
 
   p("touch_average[%d] = %d\n", (int)TouchPinId::kTouch0, touch_average[(int)TouchPinId::kTouch0]);
   p("touch_average[%d] = %d\n", (int)TouchPinId::kTouch1, touch_average[(int)TouchPinId::kTouch1]);
+  return true;
 }
 
 int Io::getTouch(const TouchPinId id) {
+  if (!touch_calibrated) {
+    return 0;
+  }
   const uint8_t read = touchRead((int)touch_pins[(int)id]);
   const auto limited = std::min(touch_average[(int)id], read);
   const auto mapped = map(limited, 0, touch_average[(int)id], 127, 0);
@@ -136,7 +152,7 @@ int Io::getTouch(const TouchPinId id) {
 
 void Io::scanInput() {
   // scan mcp
-  for (auto i = 0; i < kNumMcpInputPinId; ++i) {
+  for (auto i = 0; mcp_present && i < kNumMcpInputPinId; ++i) {
     mcp_debouncers[i].update();
     const auto id = mcpPin2Id(i);
     if (mcp_debouncers[i].fell()) {
@@ -174,6 +190,9 @@ void Io::scanInput() {
 }
 
 int Io::digitalReadMcp(const int pin) {
+  if (!mcp_present) {
+    return HIGH;  // same as nothing patched
+  }
   return mcp.digitalRead(pin);
 }
 void Io::digitalWrite(const int pin, int value) {
@@ -182,14 +201,16 @@ void Io::digitalWrite(const int pin, int value) {
   } else {
     output_buffers &= ~(1 << pin);
   }
-  mcp.writeGPIOB(output_buffers);
+  if (mcp_present) {
+    mcp.writeGPIOB(output_buffers);
+  }
 }
-int Io::analogRead(const int index) {
+int Io::analogRead(const int index, const int num_reads) {
   auto sum = 0.f;
-  for (auto i = 0; i < 5; ++i) {
+  for (auto i = 0; i < num_reads; ++i) {
     sum += mozziAnalogRead(analog_pins[index]);
   }
-  return sum / 5;
+  return sum / num_reads;
 }
 
 }  // namespace gifu_creation_koubou_2022_synth
@@ -33,6 +33,10 @@ class Io {
   static const uint8_t touch_pins[(int)TouchPinId::kNumTouch];
 
   int getTouch(const TouchPinId id);
+  // takes one touch sample per call, returns true when the average is ready.
+  // getTouch() returns 0 until then.
+  bool calibrateTouch();
+  static const int kNumTouchCalibrationReads = 100;
 
   enum InputPin {
     kSwitchPlay,         // SW1, pin 5
@@ -105,7 +109,11 @@ class Io {
     kNumAnalogPins,
   };
   static const uint8_t analog_pins[kNumAnalogPins];
-  int analogRead(const int id);
+  int analogRead(const int id, const int num_reads = 5);
+
+  bool isMcpPresent() const {
+    return mcp_present;
+  }
 
   static const int kNumMCPInput = 8;
   static const int kNumMCPOutput = 8;
@@ -113,8 +121,12 @@ class Io {
  protected:
   Adafruit_MCP23X17 mcp;
   uint8_t input_buffers[kNumMCPInput];
-  uint8_t output_buffers;
+  bool mcp_present = false;
+  uint8_t output_buffers = 0;
   uint8_t touch_average[(int)TouchPinId::kNumTouch];
+  bool touch_calibrated = false;
+  int touch_calibration_count = 0;
+  int touch_sum[(int)TouchPinId::kNumTouch] = {0, 0};
 
   bool shouldMcpInputCheckRose(const int id) {
     switch (id) {
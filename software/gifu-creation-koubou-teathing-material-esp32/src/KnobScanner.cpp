@@ -0,0 +1,80 @@
+/**
+ * @file KnobScanner.cpp
+ * @brief
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+#include "KnobScanner.h"
+
+namespace gifu_creation_koubou_2022_synth {
+
+// true if raw left the current step by more than the hysteresis
+bool KnobScanner::filter(const int index, const int raw, const int hysteresis) const {
+  const auto current = values_[index];
+  if (current < 0) {
+    return true;
+  }
+  const auto lower = (current << kValueShift) - hysteresis;
+  const auto upper = ((current + 1) << kValueShift) - 1 + hysteresis;
+  return raw < lower || raw > upper;
+}
+
+void KnobScanner::update(const int index, const int raw) {
+  if (!filter(index, raw, kHysteresis)) {
+    return;
+  }
+
+  values_[index] = raw >> kValueShift;
+  active_ticks_[index] = kActiveHoldTicks;
+  if (knobChangeCallback) {
+    knobChangeCallback(index, values_[index]);
+  }
+}
+
+int KnobScanner::nextActive() {
+  for (auto i = 0; i < kNumKnobs; ++i) {
+    const auto index = (active_index_ + i) % kNumKnobs;
+    if (active_ticks_[index] > 0) {
+      active_index_ = (index + 1) % kNumKnobs;
+      return index;
+    }
+  }
+  return -1;
+}
+
+void KnobScanner::scan() {
+  for (auto i = 0; i < kNumKnobs; ++i) {
+    if (active_ticks_[i] > 0) {
+      active_ticks_[i]--;
+    }
+  }
+
+  const auto active = nextActive();
+  if (active < 0) {
+    // nothing moving, same as the plain round robin
+    update(idle_index_, io_.analogRead(idle_index_, kNumReadsPerTick));
+    idle_index_ = (idle_index_ + 1) % kNumKnobs;
+    return;
+  }
+
+  update(active, io_.analogRead(active, kNumReadsPerTick - 1));
+
+  // probe one idle knob with the last read
+  for (auto i = 0; i < kNumKnobs; ++i) {
+    const auto index = idle_index_;
+    idle_index_ = (idle_index_ + 1) % kNumKnobs;
+    if (active_ticks_[index] > 0) {
+      continue;
+    }
+    if (filter(index, io_.analogRead(index, 1), kProbeHysteresis)) {
+      // read it properly on the next tick
+      active_ticks_[index] = kActiveHoldTicks;
+    }
+    break;
+  }
+}
+
+}  // namespace gifu_creation_koubou_2022_synth
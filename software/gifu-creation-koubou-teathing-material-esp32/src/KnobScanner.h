@@ -0,0 +1,65 @@
+/**
+ * @file KnobScanner.h
+ * @brief adaptive knob scanning, moving knobs are read more often
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+
+#pragma once
+#ifndef KNOBSCANNER_H
+#define KNOBSCANNER_H
+#include <stdint.h>
+#include <functional>
+#include "IO.h"
+
+namespace gifu_creation_koubou_2022_synth {
+
+// The ADC budget is kNumReadsPerTick conversions per control tick, the same as one Io::analogRead().
+// - nothing moving: the whole budget goes to one knob, round robin (same as before)
+// - some knob moving: kNumReadsPerTick - 1 reads go to the moving knob(s), and the last read
+//   probes one idle knob, round robin, to catch the next one being turned.
+// So a knob being turned is read every tick instead of every kNumKnobs ticks.
+// A knob falls back to idle after kActiveHoldTicks ticks without a change.
+class KnobScanner {
+ public:
+  static const int kNumKnobs = Io::kNumAnalogPins;
+  static const int kNumReadsPerTick = 5;
+  static const int kActiveHoldTicks = 32;
+  static const int kValueShift = 5;  // 12bit -> 7bit
+  // deadband around the current step, in raw adc units
+  static const int kHysteresis = 8;
+  static const int kProbeHysteresis = 24;  // single read is noisier
+
+  explicit KnobScanner(Io& io) : io_(io) {}
+
+  // call it from updateControl
+  void scan();
+
+  int value(const int index) const {
+    return values_[index];
+  }
+  bool isActive(const int index) const {
+    return active_ticks_[index] > 0;
+  }
+
+  // called with the 7bit value when a knob moved past the deadband
+  std::function<void(const int index, const int value)> knobChangeCallback;
+
+ protected:
+  bool filter(const int index, const int raw, const int hysteresis) const;
+  void update(const int index, const int raw);
+  int nextActive();
+
+  Io& io_;
+  int values_[kNumKnobs] = {-1, -1, -1, -1, -1, -1, -1, -1, -1};
+  int active_ticks_[kNumKnobs] = {};
+  int idle_index_ = 0;
+  int active_index_ = 0;
+};
+
+}  // namespace gifu_creation_koubou_2022_synth
+
+#endif  // KNOBSCANNER_H
@@ -0,0 +1,134 @@
+/**
+ * @file ModMatrix.h
+ * @brief modulation routing compiled to a flat table
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+
+#pragma once
+#ifndef MODMATRIX_H
+#define MODMATRIX_H
+#include <stdint.h>
+
+namespace gifu_creation_koubou_2022_synth {
+
+enum ModSource : uint8_t {
+  kModSourceTouch0,  // 0 - 127
+  kModSourceTouch1,  // 0 - 127
+  kModSourceLfo1,    // -128 - 127
+  kModSourceLfo2,    // -128 - 127
+  kNumModSources,
+};
+
+enum ModDestination : uint8_t {
+  kModDestAmp,
+  kModDestLfo1Speed,
+  kModDestLfo1Depth,
+  kModDestPitch,
+  kModDestAm,
+  kNumModDestinations,
+};
+
+// The patch state is a source x destination table of depths, 0 meaning not patched.
+// Whenever a route appears or disappears the table is compiled into a dense list of
+// (source, destination, depth), so process() only walks the patched routes.
+// Changing the depth of an existing route just updates its entry.
+class ModMatrix {
+ public:
+  struct Route {
+    uint8_t source;
+    uint8_t destination;
+    int16_t depth;
+  };
+  static const int kMaxRoutes = kNumModSources * kNumModDestinations;
+
+  void setRoute(const ModSource source, const ModDestination destination, const int16_t depth) {
+    if (depth == 0) {
+      removeRoute(source, destination);
+      return;
+    }
+    const auto old_depth = depths_[source][destination];
+    depths_[source][destination] = depth;
+    if (old_depth == 0) {
+      compile();
+      return;
+    }
+    depth_sums_[destination] += depth - old_depth;
+    for (auto i = 0; i < num_routes_; ++i) {
+      if (routes_[i].source == source && routes_[i].destination == destination) {
+        routes_[i].depth = depth;
+        break;
+      }
+    }
+  }
+
+  void removeRoute(const ModSource source, const ModDestination destination) {
+    if (depths_[source][destination] == 0) {
+      return;
+    }
+    depths_[source][destination] = 0;
+    compile();
+  }
+
+  bool isRouted(const ModDestination destination) const {
+    return (routed_destinations_ & (1 << destination)) != 0;
+  }
+
+  bool usesSource(const ModSource source) const {
+    return (used_sources_ & (1 << source)) != 0;
+  }
+
+  // sum of the depths routed to the destination, for unipolar destinations which need an offset
+  int32_t depthSum(const ModDestination destination) const {
+    return depth_sums_[destination];
+  }
+
+  // destinations[d] = sum of sources[s] * depth over the patched routes.
+  // destinations which are not routed are left at 0.
+  inline void process(const int16_t* sources, int32_t* destinations) const {
+    for (auto i = 0; i < kNumModDestinations; ++i) {
+      destinations[i] = 0;
+    }
+    const auto end = routes_ + num_routes_;
+    for (auto route = routes_; route != end; ++route) {
+      destinations[route->destination] += (int32_t)sources[route->source] * route->depth;
+    }
+  }
+
+ protected:
+  void compile() {
+    num_routes_ = 0;
+    routed_destinations_ = 0;
+    used_sources_ = 0;
+    for (auto d = 0; d < kNumModDestinations; ++d) {
+      depth_sums_[d] = 0;
+    }
+
+    for (auto s = 0; s < kNumModSources; ++s) {
+      for (auto d = 0; d < kNumModDestinations; ++d) {
+        const auto depth = depths_[s][d];
+        if (depth == 0) {
+          continue;
+        }
+        routes_[num_routes_++] = {(uint8_t)s, (uint8_t)d, depth};
+        routed_destinations_ |= (1 << d);
+        used_sources_ |= (1 << s);
+        depth_sums_[d] += depth;
+      }
+    }
+  }
+
+  int16_t depths_[kNumModSources][kNumModDestinations] = {};
+  Route routes_[kMaxRoutes];
+  int num_routes_ = 0;
+  uint8_t routed_destinations_ = 0;
+  uint8_t used_sources_ = 0;
+  int32_t depth_sums_[kNumModDestinations] = {};
+};
+
+}  // namespace gifu_creation_koubou_2022_synth
+
+#endif  // MODMATRIX_H
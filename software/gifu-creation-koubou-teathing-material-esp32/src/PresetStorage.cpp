@@ -0,0 +1,108 @@
+/**
+ * @file PresetStorage.cpp
+ * @brief
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+#include "PresetStorage.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace gifu_creation_koubou_2022_synth {
+
+#ifdef ARDUINO
+namespace {
+void slotKey(const int slot, char* key) {
+  // "p0", "p1", ...
+  key[0] = 'p';
+  key[1] = '0' + slot;
+  key[2] = '\0';
+}
+}  // namespace
+
+bool NvsPresetStorage::begin() {
+  return preferences.begin("presets", false);
+}
+
+bool NvsPresetStorage::read(const int slot, void* data, const size_t size) {
+  char key[3];
+  slotKey(slot, key);
+  return preferences.getBytes(key, data, size) == size;
+}
+
+bool NvsPresetStorage::write(const int slot, const void* data, const size_t size) {
+  char key[3];
+  slotKey(slot, key);
+  return preferences.putBytes(key, data, size) == size;
+}
+
+#else
+
+bool FilePresetStorage::begin() {
+  auto file = fopen(path_, "rb");
+  if (file) {
+    fclose(file);
+    return true;
+  }
+  file = fopen(path_, "wb");
+  if (!file) {
+    return false;
+  }
+  fclose(file);
+  return true;
+}
+
+bool FilePresetStorage::read(const int slot, void* data, const size_t size) {
+  if (size > slot_size_) {
+    return false;
+  }
+  auto file = fopen(path_, "rb");
+  if (!file) {
+    return false;
+  }
+  auto ok = fseek(file, slot * slot_size_, SEEK_SET) == 0 && fread(data, 1, size, file) == size;
+  fclose(file);
+  if (!ok) {
+    return false;
+  }
+
+  // all 0xff: never written
+  auto bytes = (const uint8_t*)data;
+  for (size_t i = 0; i < size; ++i) {
+    if (bytes[i] != 0xff) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FilePresetStorage::write(const int slot, const void* data, const size_t size) {
+  if (size > slot_size_) {
+    return false;
+  }
+  auto file = fopen(path_, "r+b");
+  if (!file) {
+    return false;
+  }
+
+  // grow the file as erased flash up to the slot
+  fseek(file, 0, SEEK_END);
+  const auto end = (size_t)ftell(file);
+  const auto needed = (slot + 1) * slot_size_;
+  for (auto i = end; i < needed; ++i) {
+    fputc(0xff, file);
+  }
+
+  auto ok = fseek(file, slot * slot_size_, SEEK_SET) == 0 && fwrite(data, 1, size, file) == size;
+  fclose(file);
+  if (ok) {
+    write_count_++;
+  }
+  return ok;
+}
+#endif
+
+}  // namespace gifu_creation_koubou_2022_synth
@@ -0,0 +1,67 @@
+/**
+ * @file PresetStorage.h
+ * @brief non-volatile backends for PresetStore
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+
+#pragma once
+#ifndef PRESETSTORAGE_H
+#define PRESETSTORAGE_H
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef ARDUINO
+#include <Preferences.h>
+#endif
+
+namespace gifu_creation_koubou_2022_synth {
+
+// one fixed size blob per slot
+class PresetStorage {
+ public:
+  virtual ~PresetStorage() = default;
+  virtual bool begin() = 0;
+  // returns false if the slot has never been written
+  virtual bool read(const int slot, void* data, const size_t size) = 0;
+  virtual bool write(const int slot, const void* data, const size_t size) = 0;
+};
+
+#ifdef ARDUINO
+// NVS on the ESP32. NVS spreads the writes over its pages by itself, so this gives us wear leveling for free.
+class NvsPresetStorage : public PresetStorage {
+ public:
+  bool begin() override;
+  bool read(const int slot, void* data, const size_t size) override;
+  bool write(const int slot, const void* data, const size_t size) override;
+
+ protected:
+  Preferences preferences;
+};
+#else
+// file backed flash emulator for host builds.
+// the file behaves like erased flash (0xff) until a slot is written.
+class FilePresetStorage : public PresetStorage {
+ public:
+  FilePresetStorage(const char* path, const size_t slot_size) : path_(path), slot_size_(slot_size) {}
+  bool begin() override;
+  bool read(const int slot, void* data, const size_t size) override;
+  bool write(const int slot, const void* data, const size_t size) override;
+
+  int writeCount() const {
+    return write_count_;
+  }
+
+ protected:
+  const char* path_;
+  size_t slot_size_;
+  int write_count_ = 0;
+};
+#endif
+
+}  // namespace gifu_creation_koubou_2022_synth
+
+#endif  // PRESETSTORAGE_H
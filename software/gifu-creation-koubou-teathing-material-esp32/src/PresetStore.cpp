@@ -0,0 +1,138 @@
+/**
+ * @file PresetStore.cpp
+ * @brief
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+#include "PresetStore.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+static portMUX_TYPE preset_mux = portMUX_INITIALIZER_UNLOCKED;
+#define PRESET_LOCK() portENTER_CRITICAL(&preset_mux)
+#define PRESET_UNLOCK() portEXIT_CRITICAL(&preset_mux)
+#else
+#define PRESET_LOCK()
+#define PRESET_UNLOCK()
+#endif
+
+namespace gifu_creation_koubou_2022_synth {
+
+uint16_t PresetStore::checksum(const Patch& patch) {
+  // fletcher-16
+  auto bytes = (const uint8_t*)&patch;
+  uint16_t sum1 = 0;
+  uint16_t sum2 = 0;
+  for (size_t i = 0; i < sizeof(Patch); ++i) {
+    sum1 = (sum1 + bytes[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
+
+bool PresetStore::begin() {
+  if (!storage_.begin()) {
+    return false;
+  }
+
+  for (auto i = 0; i < kNumPresets; ++i) {
+    auto& record = records_[i];
+    valid_[i] = storage_.read(i, &record, sizeof(Record)) &&
+                record.magic == kMagic &&
+                record.version == kVersion &&
+                record.size == sizeof(Patch) &&
+                record.checksum == checksum(record.patch);
+  }
+  dirty_ = 0;
+  return true;
+}
+
+bool PresetStore::recall(const int slot, Patch& patch) const {
+  if (slot < 0 || slot >= kNumPresets) {
+    return false;
+  }
+
+  PRESET_LOCK();
+  const auto valid = valid_[slot];
+  if (valid) {
+    patch = records_[slot].patch;
+  }
+  PRESET_UNLOCK();
+  return valid;
+}
+
+void PresetStore::store(const int slot, const Patch& patch) {
+  if (slot < 0 || slot >= kNumPresets) {
+    return;
+  }
+
+  Record record;
+  record.magic = kMagic;
+  record.version = kVersion;
+  record.size = sizeof(Patch);
+  record.patch = patch;
+  record.checksum = checksum(patch);
+
+  PRESET_LOCK();
+  const auto changed = !valid_[slot] || memcmp(&records_[slot], &record, sizeof(Record)) != 0;
+  if (changed) {
+    records_[slot] = record;
+    valid_[slot] = true;
+    dirty_ |= (1 << slot);
+  }
+  PRESET_UNLOCK();
+
+#ifdef ARDUINO
+  if (changed && commit_task_) {
+    xTaskNotifyGive((TaskHandle_t)commit_task_);
+  }
+#endif
+}
+
+void PresetStore::commit() {
+  for (auto i = 0; i < kNumPresets; ++i) {
+    Record record;
+    PRESET_LOCK();
+    const auto is_dirty = (dirty_ & (1 << i)) != 0;
+    if (is_dirty) {
+      record = records_[i];
+      dirty_ &= ~(1 << i);
+    }
+    PRESET_UNLOCK();
+
+    if (!is_dirty) {
+      continue;
+    }
+    if (!storage_.write(i, &record, sizeof(Record))) {
+      // try again next time
+      PRESET_LOCK();
+      dirty_ |= (1 << i);
+      PRESET_UNLOCK();
+    }
+  }
+}
+
+#ifdef ARDUINO
+void PresetStore::commitTask(void* arg) {
+  auto store = (PresetStore*)arg;
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    store->commit();
+  }
+}
+
+void PresetStore::startBackgroundCommit() {
+  if (commit_task_) {
+    return;
+  }
+  TaskHandle_t handle = nullptr;
+  xTaskCreatePinnedToCore(commitTask, "preset commit", 4096, this, 1, &handle, 0);
+  commit_task_ = handle;
+}
+#endif
+
+}  // namespace gifu_creation_koubou_2022_synth
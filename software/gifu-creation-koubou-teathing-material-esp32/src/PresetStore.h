@@ -0,0 +1,84 @@
+/**
+ * @file PresetStore.h
+ * @brief patch presets kept in RAM and committed to flash in the background
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+
+#pragma once
+#ifndef PRESETSTORE_H
+#define PRESETSTORE_H
+#include <stdint.h>
+#include "PresetStorage.h"
+
+namespace gifu_creation_koubou_2022_synth {
+
+struct Patch {
+  static const int kNumSteps = 8;
+  uint16_t seq_freqs[kNumSteps];
+  uint16_t attack;
+  uint16_t decay;
+  uint16_t release;
+  uint8_t sustain;
+  uint8_t lfo1_freq;
+  uint8_t lfo1_depth;  // 0-127
+  uint8_t lfo2_freq;
+  uint8_t lfo2_depth;  // 0-127
+  uint8_t bpm;
+};
+
+// All slots are mirrored in RAM, so recall() is a memcpy and is safe to call from updateControl().
+// store() only updates the mirror, the flash write is done later by commit().
+class PresetStore {
+ public:
+  static const int kNumPresets = 8;
+  static const uint8_t kVersion = 1;
+
+  explicit PresetStore(PresetStorage& storage) : storage_(storage) {}
+
+  // loads every slot from the storage. slots with a bad header or checksum are left empty.
+  bool begin();
+
+  // returns false if the slot is empty
+  bool recall(const int slot, Patch& patch) const;
+  void store(const int slot, const Patch& patch);
+
+  bool isDirty() const {
+    return dirty_ != 0;
+  }
+  // writes the dirty slots. unchanged slots are never rewritten.
+  void commit();
+
+#ifdef ARDUINO
+  // commit() is run by a low priority task on core 0 whenever store() is called
+  void startBackgroundCommit();
+#endif
+
+  struct Record {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t size;
+    Patch patch;
+    uint16_t checksum;
+  };
+  static const uint16_t kMagic = 0x4743;  // "GC"
+
+ protected:
+  static uint16_t checksum(const Patch& patch);
+
+  PresetStorage& storage_;
+  Record records_[kNumPresets];
+  bool valid_[kNumPresets] = {};
+  volatile uint32_t dirty_ = 0;
+#ifdef ARDUINO
+  void* commit_task_ = nullptr;
+  static void commitTask(void* arg);
+#endif
+};
+
+}  // namespace gifu_creation_koubou_2022_synth
+
+#endif  // PRESETSTORE_H
@@ -11,11 +11,16 @@
 #include <SoftwareSerial.h>
 #include <DFRobotDFPlayerMini.h>
 
-#include <ADSR.h>
+#include <ADSRCurved.h>
+#include <Glide.h>
 
 #include "IO.h"
 #include "FakeTimerInterrupt.h"
 #include "SerialUtility.h"
+#include "BootSequence.h"
+#include "PresetStore.h"
+#include "KnobScanner.h"
+#include "ModMatrix.h"
 
 constexpr int SAMPLING_RATE = AUDIO_RATE;
 
@@ -25,7 +30,11 @@ using namespace gifu_creation_koubou_2022_synth;
 #define TX (19)
 
 DFRobotDFPlayerMini dfPlayer;
+volatile bool audio_player_ready = false;
 gifu_creation_koubou_2022_synth::Io io;
+KnobScanner knobs(io);
+void onKnobChanged(const int index, int value);  // knobs.knobChangeCallback, set in setup()
+BootSequence boot;
 
 const uint8_t touch_pins[2] = {
     13,
@@ -82,9 +91,9 @@ float getNormalizedFrequency(const int value, const int value_max, const int fre
 }
 
 struct Synth {
-  int attack = 10;
-  int decay = 10;
-  int sustain = 100;
+  int attack = 0;
+  int decay = 0;
+  int sustain = 255;
   int release = 0;
 };
 Synth synth;
@@ -118,26 +127,58 @@ enum {
 };
 int osc_type = kOscSquare;
 
-bool touch_amp_enabled = false;
-bool touch_lfo_speed_enabled = false;
-bool touch_lfo_depth_enabled = false;
-
-ADSR<CONTROL_RATE, AUDIO_RATE> envelope;
+ADSRCurved<CONTROL_RATE, AUDIO_RATE> envelope;
 Oscil<SQUARE_ANALOGUE512_NUM_CELLS, AUDIO_RATE> squareWave(SQUARE_ANALOGUE512_DATA);
 Oscil<SAW_ANALOGUE512_NUM_CELLS, AUDIO_RATE> sawWave(SAW_ANALOGUE512_DATA);
 WhiteNoise whiteNoise;
 
+// both oscillators have 512 cell tables, so they share one phase increment, which glides between
+// sequencer steps and which the pitch modulation scales, every sample
+static_assert(SQUARE_ANALOGUE512_NUM_CELLS == SAW_ANALOGUE512_NUM_CELLS, "oscillators share a phase increment");
+constexpr unsigned int kSeqGlideMsec = 30;
+Glide<AUDIO_RATE> osc_glide;
+void setOscFreq(const int freq) {
+  osc_glide.set(squareWave.phaseIncFromFreq(freq));
+}
+void glideOscFreq(const int freq) {
+  osc_glide.start(squareWave.phaseIncFromFreq(freq));
+}
+
 // LFO
 Oscil<2048, AUDIO_RATE> lfo1(SIN2048_DATA);
 Oscil<2048, AUDIO_RATE> lfo2(SIN2048_DATA);
+int lfo1_freq = 0;
+int lfo2_freq = 0;
 float lfo1_depth = 0.0;
 float lfo2_depth = 0.0;
 
+// modulation routing, patch cables add and remove routes
+ModMatrix control_matrix;  // evaluated once per control tick
+ModMatrix audio_matrix;    // evaluated every sample
+// depth 128 passes the source through as is
+constexpr int16_t kModDepthUnity = 128;
+
+void setLfo1Depth(const float depth) {
+  lfo1_depth = depth;
+  const int am_depth = lfo1_depth * 127;
+  // AM_modulate() works on depth + 128
+  audio_matrix.setRoute(kModSourceLfo1, kModDestAm, am_depth < 1 ? 0 : am_depth + 128);
+}
+
+void setLfo2Depth(const float depth) {
+  lfo2_depth = depth;
+  audio_matrix.setRoute(kModSourceLfo2, kModDestPitch, (int)(lfo2_depth * 255));
+}
+
+// presets
+NvsPresetStorage preset_storage;
+PresetStore presets(preset_storage);
+int preset_slot = 0;
+
 bool tick_flag = false;
 void bpmTick() {
   if (transport.playing) {
-    squareWave.setFreq(seq_freqs[seq_step]);
-    sawWave.setFreq(seq_freqs[seq_step]);
+    glideOscFreq(seq_freqs[seq_step]);
 
     envelope.noteOff();
     envelope.noteOn(true);
@@ -207,8 +248,7 @@ void onSwitchTrigger(const int low_hi) {
   p("onSwitchTrigger, low_hi = %d\n", low_hi);
 
   if (!low_hi) {
-    squareWave.setFreq(seq_freqs[0]);
-    sawWave.setFreq(seq_freqs[0]);
+    setOscFreq(seq_freqs[0]);
     envelope.noteOn();
 
   } else {
@@ -229,6 +269,10 @@ void onSwitchMode(const int low_hi) {
 bool audioPlayerPlaying = false;
 void onSwitchAudioPlayer(const int low_hi) {
   p("onSwitchAudioPlayer\n");
+  if (!audio_player_ready) {
+    p("DFPlayer not available\n");
+    return;
+  }
   audioPlayerPlaying = !audioPlayerPlaying;
   if (audioPlayerPlaying) {
     dfPlayer.loop(1);
@@ -265,28 +309,142 @@ void onPatchNoise(const int low_hi) {
 }
 
 void onPatchTouchAmp(const int low_hi) {
-  touch_amp_enabled = !low_hi;
-  p("touch_amp_enabled = %d\n", touch_amp_enabled);
+  const auto enabled = !low_hi;
+  audio_matrix.setRoute(kModSourceTouch0, kModDestAmp, enabled ? kModDepthUnity : 0);
+  p("touch_amp_enabled = %d\n", enabled);
 }
 void onPatchTouchLFOSpeed(const int low_hi) {
-  touch_lfo_speed_enabled = !low_hi;
-  p("touch_lfo_speed_enabled = %d\n", touch_lfo_speed_enabled);
+  const auto enabled = !low_hi;
+  control_matrix.setRoute(kModSourceTouch0, kModDestLfo1Speed, enabled ? kModDepthUnity : 0);
+  p("touch_lfo_speed_enabled = %d\n", enabled);
 }
 void onPatchTouchLFODepth(const int low_hi) {
-  touch_lfo_depth_enabled = !low_hi;
-  p("touch_lfo_depth_enabled = %d\n", touch_lfo_depth_enabled);
+  const auto enabled = !low_hi;
+  control_matrix.setRoute(kModSourceTouch1, kModDestLfo1Depth, enabled ? kModDepthUnity : 0);
+  p("touch_lfo_depth_enabled = %d\n", enabled);
+}
+
+Patch capturePatch() {
+  Patch patch;
+  for (auto i = 0; i < Patch::kNumSteps; ++i) {
+    patch.seq_freqs[i] = seq_freqs[i];
+  }
+  patch.attack = synth.attack;
+  patch.decay = synth.decay;
+  patch.sustain = synth.sustain;
+  patch.release = synth.release;
+  patch.lfo1_freq = lfo1_freq;
+  patch.lfo1_depth = lfo1_depth * 127;
+  patch.lfo2_freq = lfo2_freq;
+  patch.lfo2_depth = lfo2_depth * 127;
+  patch.bpm = transport.bpm;
+  return patch;
+}
+
+void applyPatch(const Patch& patch) {
+  for (auto i = 0; i < Patch::kNumSteps; ++i) {
+    seq_freqs[i] = patch.seq_freqs[i];
+  }
+
+  synth.attack = patch.attack;
+  synth.decay = patch.decay;
+  synth.sustain = patch.sustain;
+  synth.release = patch.release;
+  envelope.setAttackTime(synth.attack);
+  envelope.setDecayTime(synth.decay);
+  envelope.setDecayLevel(synth.sustain);
+  envelope.setSustainLevel(synth.sustain);
+  envelope.setReleaseTime(synth.release);
+
+  lfo1_freq = patch.lfo1_freq;
+  setLfo1Depth(patch.lfo1_depth / 127.0);
+  lfo2_freq = patch.lfo2_freq;
+  setLfo2Depth(patch.lfo2_depth / 127.0);
+  lfo1.setFreq(lfo1_freq);
+  lfo2.setFreq(lfo2_freq);
+
+  transport.bpm = patch.bpm;
+  bpmtick.setIntervalMsec(60000 / transport.bpm / 4);
+}
+
+// SW3: recall the next preset
+void onSwitchPresetRecall(const int low_hi) {
+  preset_slot = (preset_slot + 1) % PresetStore::kNumPresets;
+  Patch patch;
+  if (presets.recall(preset_slot, patch)) {
+    applyPatch(patch);
+    p("preset %d recalled\n", preset_slot);
+  } else {
+    p("preset %d is empty\n", preset_slot);
+  }
+}
+
+// SW6: store the current patch to the current preset
+void onSwitchPresetStore(const int low_hi) {
+  presets.store(preset_slot, capturePatch());
+  p("preset %d stored\n", preset_slot);
+}
+
+// DFPlayer takes up to a few seconds to answer, so it is brought up on the other core
+void audioPlayerBootTask(void* arg) {
+  boot.startStage(BootSequence::kStageAudioPlayer);
+  swSer.begin(9600);
+
+  auto ok = false;
+  for (auto i = 0; i < 5; i++) {
+    if (dfPlayer.begin(swSer)) {
+      ok = true;
+      break;
+    }
+    delay(500);
+  }
+
+  if (ok) {
+    Serial.println(F("DFPlayer Mini online."));
+    dfPlayer.reset();
+    dfPlayer.volume(30);
+  } else {
+    Serial.println(F("DFPlayer Mini not found."));
+  }
+  audio_player_ready = ok;
+  boot.finishStage(BootSequence::kStageAudioPlayer, ok);
+
+  vTaskDelete(nullptr);
 }
 
 void setup() {
+  boot.begin();
   Serial.begin(115200);
-  swSer.begin(9600);
 
   Serial.println("Hello!");
 
+  // audio first
+  boot.startStage(BootSequence::kStageAudio);
+  envelope.setAttackTime(synth.attack);
+  envelope.setAttackLevel(255);
+  envelope.setDecayLevel(synth.sustain);
+  envelope.setReleaseLevel(1);
+  envelope.setDecayTime(synth.decay);
+  envelope.setSustainLevel(synth.sustain);
+  envelope.setSustainTime(UINT32_MAX);
+  envelope.setReleaseTime(synth.release);
+  envelope.setCurves(ADSR_CURVE_LINEAR, ADSR_CURVE_EXP, ADSR_CURVE_EXP);
+  bpmtick.setCallback(bpmTick);
+  bpmtick.setIntervalMsec(250);
+
+  startMozzi(CONTROL_RATE);
+  osc_glide.setTime(kSeqGlideMsec);
+  setOscFreq(1000);
+  boot.finishStage(BootSequence::kStageAudio, true);
+
+  // io
+  boot.startStage(BootSequence::kStageIo);
   io.inputChangeCallbacks[Io::kSwitchPlay] = onSwitchPlay;
   io.inputChangeCallbacks[Io::kSwitchTrigger] = onSwitchTrigger;
   io.inputChangeCallbacks[Io::kSwitchMode] = onSwitchMode;
   io.inputChangeCallbacks[Io::kSwitchAudioPlayer] = onSwitchAudioPlayer;
+  io.inputChangeCallbacks[Io::kSw3] = onSwitchPresetRecall;
+  io.inputChangeCallbacks[Io::kSw6] = onSwitchPresetStore;
 
   // patching
   io.inputChangeCallbacks[Io::kPatchSaw] = onPatchSaw;
@@ -297,38 +455,22 @@ void setup() {
   io.inputChangeCallbacks[Io::kPatchTouchLFOSpeed] = onPatchTouchLFOSpeed;
   io.inputChangeCallbacks[Io::kPatchTouchLFODepth] = onPatchTouchLFODepth;
   io.setup();
+  knobs.knobChangeCallback = onKnobChanged;
 
   setMode(kModeSeq);
+  boot.finishStage(BootSequence::kStageIo, io.isMcpPresent());
 
-  for (auto i = 0; i < 5; i++) {
-    if (dfPlayer.begin(swSer)) {
-      break;
-      delay(500);
-    }
+  boot.startStage(BootSequence::kStagePresets);
+  const auto presets_ok = presets.begin();
+  if (presets_ok) {
+    presets.startBackgroundCommit();
   }
+  boot.finishStage(BootSequence::kStagePresets, presets_ok);
 
-  Serial.println(F("DFPlayer Mini online."));
-  dfPlayer.reset();
-  dfPlayer.volume(30);
-
-  delay(1000);
-
-  startMozzi(CONTROL_RATE);
-  squareWave.setFreq(1000);
-  sawWave.setFreq(1000);
-
-  envelope.setAttackTime(0);
-  envelope.setAttackLevel(255);
-  envelope.setDecayLevel(255);
-  envelope.setReleaseLevel(1);
-  envelope.setDecayTime(0);
-  envelope.setSustainLevel(255);
-  envelope.setSustainTime(UINT32_MAX);
-  envelope.setReleaseTime(0);
-  bpmtick.setCallback(bpmTick);
+  // touch calibration runs in updateControl()
+  boot.startStage(BootSequence::kStageTouch);
 
-  bpmtick.setCallback(bpmTick);
-  bpmtick.setIntervalMsec(250);
+  xTaskCreatePinnedToCore(audioPlayerBootTask, "dfplayer boot", 4096, nullptr, 1, nullptr, 0);
 }
 
 auto last_analog_value = 0;
@@ -341,144 +483,178 @@ void setSeqFreq(const int index, const int freq) {
 
   seq_freqs[index] = freq;
 }
-int analog_read_index = 0;
+// called by the knob scanner when a knob moved past its deadband
+void onKnobChanged(const int index, int value) {
+  if (index == 0) {
+    value = map(value, 19, 127, 0, 127);
+  }
+  raw_knob_values[index] = value;
+  switch (mode) {
+    case kModeSeq: {
+      const auto freq = mtof(value);
+      setSeqFreq(index, freq);
+      if (!transport.playing) {
+        const auto freq = mtof(raw_knob_values[0]);
+        setOscFreq(freq);
+        last_freq = freq;
+      }
+    } break;
+    case kModeEG: {
+      if (index == 0) {
+        const auto attack = value << 5;
+        p("attack = %d\n", attack);
+        synth.attack = attack;
+        envelope.setAttackTime(attack);
+      }
+      if (index == 1) {
+        const auto decay = value << 5;
+        p("decay = %d\n", decay);
+        synth.decay = decay;
+        envelope.setDecayTime(decay);
+      }
+      if (index == 2) {
+        const auto sustain = value << 1;
+        p("sustain = %d\n", sustain);
+        synth.sustain = sustain;
+        envelope.setDecayLevel(sustain);
+        envelope.setSustainLevel(sustain);
+      }
+      if (index == 3) {
+        const auto release = value << 5;
+        synth.release = release;
+        envelope.setReleaseTime(release);
+      }
+
+    } break;
+    case kModeLFO:
+      if (index == 0) {
+        if (!control_matrix.isRouted(kModDestLfo1Speed)) {
+          lfo1_freq = value >> 2;
+          p("lfo_freq = %d\n", lfo1_freq);
+          lfo1.setFreq(lfo1_freq);
+        }
+      }
+      if (index == 1) {
+        if (!control_matrix.isRouted(kModDestLfo1Depth)) {
+          setLfo1Depth(value / 127.0);
+          p("lfo_depth = %f\n", lfo1_depth);
+        }
+      }
+      if (index == 2) {
+        lfo2_freq = value >> 2;
+        p("lfo2_freq = %d\n", lfo2_freq);
+        lfo2.setFreq(lfo2_freq);
+      }
+      if (index == 3) {
+        setLfo2Depth(value / 127.0);
+        p("lfo2_depth = %f\n", lfo2_depth);
+      }
+      break;
+    default:
+      break;
+
+      // update triggered pitch
+  }
+
+  // update bpm
+  if (index == 8) {
+    const auto bpm = map(value, 0, 4096 >> 5, 30, 240);
+    const auto absDelta = abs(bpm - transport.bpm);
+    if (absDelta >= 2) {
+      transport.bpm = bpm;
+      bpmtick.setIntervalMsec(60000 / transport.bpm / 4);
+      //p("BPM: %d\n", transport.bpm);
+    }
+  }
+}
+
 void updateControl() {
+  if (!boot.isFinished(BootSequence::kStageTouch)) {
+    if (io.calibrateTouch()) {
+      boot.finishStage(BootSequence::kStageTouch, true);
+    }
+  }
+  boot.reportIfFinished();
+
   envelope.update();
   io.scanInput();
   last_touch_value[0] = io.getTouch(Io::TouchPinId::kTouch0);
   last_touch_value[1] = io.getTouch(Io::TouchPinId::kTouch1);
-  if (touch_lfo_speed_enabled) {
-    const auto lfo_freq = last_touch_value[0] >> 2;
-    lfo1.setFreq(lfo_freq);
+
+  const int16_t control_sources[kNumModSources] = {last_touch_value[0], last_touch_value[1], 0, 0};
+  int32_t control_mod[kNumModDestinations];
+  control_matrix.process(control_sources, control_mod);
+  if (control_matrix.isRouted(kModDestLfo1Speed)) {
+    lfo1_freq = (control_mod[kModDestLfo1Speed] >> 7) >> 2;
+    lfo1.setFreq(lfo1_freq);
   }
-  if (touch_lfo_depth_enabled) {
-    lfo1_depth = last_touch_value[1] / 127.0;
+  if (control_matrix.isRouted(kModDestLfo1Depth)) {
+    setLfo1Depth((control_mod[kModDestLfo1Depth] >> 7) / 127.0);
   }
   io.digitalWrite(Io::kBpmLed, tick_flag);
   if (tick_flag) {
     tick_flag = 0;
   }
 
-  auto value = io.analogRead(analog_read_index) >> 5;
-  if (analog_read_index == 0) {
-    value = map(value, 19, 127, 0, 127);
-  }
-  if (value != raw_knob_values[analog_read_index]) {
-    raw_knob_values[analog_read_index] = value;
-    //p("raw_knob_values[%d] = %d\n", i, value);
-    switch (mode) {
-      case kModeSeq: {
-        const auto freq = mtof(value);
-        setSeqFreq(analog_read_index, freq);
-        if (!transport.playing) {
-          const auto freq = mtof(raw_knob_values[0]);
-          squareWave.setFreq(freq);
-          sawWave.setFreq(freq);
-          last_freq = freq;
-        }
-      } break;
-      case kModeEG: {
-        if (analog_read_index == 0) {
-          const auto attack = value << 5;
-          p("attack = %d\n", attack);
-          envelope.setAttackTime(attack);
-        }
-        if (analog_read_index == 1) {
-          const auto decay = value << 5;
-          p("decay = %d\n", decay);
-          envelope.setDecayTime(value << 5);
-        }
-        if (analog_read_index == 2) {
-          const auto sustain = value << 1;
-          p("sustain = %d\n", sustain);
-          envelope.setDecayLevel(sustain);
-          envelope.setSustainLevel(sustain);
-        }
-        if (analog_read_index == 3) {
-          const auto release = value << 5;
-          envelope.setReleaseTime(release);
-        }
-
-      } break;
-      case kModeLFO:
-        if (analog_read_index == 0) {
-          if (!touch_lfo_speed_enabled) {
-            const auto lfo_freq = value >> 2;
-            p("lfo_freq = %d\n", lfo_freq);
-            lfo1.setFreq(lfo_freq);
-          }
-        }
-        if (analog_read_index == 1) {
-          if (!touch_lfo_depth_enabled) {
-            lfo1_depth = value / 127.0;
-            p("lfo_depth = %f\n", lfo1_depth);
-          }
-        }
-        if (analog_read_index == 2) {
-          const auto lfo2_freq = value >> 2;
-          p("lfo2_freq = %d\n", lfo2_freq);
-          lfo2.setFreq(lfo2_freq);
-        }
-        if (analog_read_index == 3) {
-          lfo2_depth = value / 127.0;
-          p("lfo2_depth = %f\n", lfo2_depth);
-        }
-        break;
-      default:
-        break;
-
-        // update triggered pitch
-    }
-
-    // update bpm
-    if (analog_read_index == 8) {
-      auto bpm = io.analogRead(Io::kV9) >> 5;
-      bpm = map(bpm, 0, 4096 >> 5, 30, 240);
-      const auto absDelta = abs(bpm - transport.bpm);
-      if (absDelta >= 2) {
-        transport.bpm = bpm;
-        bpmtick.setIntervalMsec(60000 / transport.bpm / 4);
-        //p("BPM: %d\n", transport.bpm);
-      }
-    }
-  }
-  analog_read_index++;
-  analog_read_index = analog_read_index % 9;
+  knobs.scan();
 }
 
-int8_t AM_modulate(int8_t carrier, int8_t modulation, int8_t depth) {
-  if (depth < 1) {
-    return carrier;
-  }
-  int16_t sample = (int16_t)carrier;                    // carrier is signed
-  uint16_t am = (uint16_t)((int16_t)modulation + 128);  // unsigned modulation 0..255
-  uint16_t dp = (uint16_t)((int16_t)depth + 128);       // unsigned depth 0..255
+// modulation: sum of modulator * depth, depth_sum: sum of the depths (128..255 each)
+int8_t AM_modulate(int8_t carrier, int32_t modulation, int32_t depth_sum) {
+  int16_t sample = (int16_t)carrier;  // carrier is signed
+  // same as ((modulation + 128) * depth >> 8) + (255 - depth) for a single modulator
+  const auto gain = 255 + ((modulation - (depth_sum << 7)) >> 8);
 
-  return (int8_t)((sample * (((am * dp) >> 8) + (255 - dp))) >> 8);
+  return (int8_t)((sample * gain) >> 8);
 }
 int updateAudio() {
-  auto get_output = [](Q15n16 pitch_mod) -> int8_t {
+  auto get_output = []() -> int8_t {
     switch (osc_type) {
       case kOscSaw:
-        return sawWave.phMod(pitch_mod);
+        return sawWave.next();
       case kOscNoise:
         return whiteNoise.next();
       case kOscSquare:  // FALLTHRU
       default:
-        return squareWave.phMod(pitch_mod);
+        return squareWave.next();
     }
   };
   bpmtick.tick();
-  Q15n16 pitch_lfo_out = (Q15n16)(lfo2.next() * ((int)(lfo2_depth * 255)));
 
-  auto out = get_output(pitch_lfo_out);
-  if (touch_amp_enabled) {
-    out = (out * last_touch_value[0]) >> 7;
+  // once the envelope has finished, the output is silent whatever the modulators and oscillators
+  // do, so they are left alone and the time goes back to loop(); the glide still keeps time
+  if (!envelope.playing()) {
+    osc_glide.next();
+    return 0;
   }
 
-  auto lfo1_out = lfo1.next();
-  auto am_modulated = AM_modulate(out, lfo1_out, (int)(lfo1_depth * 127));
-  return (int)(envelope.next() * am_modulated) >> 8;
+  // only the modulators which are patched somewhere are stepped
+  int16_t sources[kNumModSources] = {last_touch_value[0], last_touch_value[1], 0, 0};
+  if (audio_matrix.usesSource(kModSourceLfo1)) {
+    sources[kModSourceLfo1] = lfo1.next();
+  }
+  if (audio_matrix.usesSource(kModSourceLfo2)) {
+    sources[kModSourceLfo2] = lfo2.next();
+  }
+  int32_t mod[kNumModDestinations];
+  audio_matrix.process(sources, mod);
+
+  // vibrato moves the pitch, up to 3 semitones either way at full depth (+-0.25 octave in Q15n16)
+  unsigned long phase_inc = osc_glide.next();
+  if (audio_matrix.isRouted(kModDestPitch)) {
+    phase_inc = mult_s32x32_shr<16>(phase_inc, Q16n16_exp2(mod[kModDestPitch] >> 1));
+  }
+  squareWave.setPhaseInc(phase_inc);
+  sawWave.setPhaseInc(phase_inc);
+
+  auto out = get_output();
+  if (audio_matrix.isRouted(kModDestAmp)) {
+    out = (out * (mod[kModDestAmp] >> 7)) >> 7;
+  }
+  if (audio_matrix.isRouted(kModDestAm)) {
+    out = AM_modulate(out, mod[kModDestAm], audio_matrix.depthSum(kModDestAm));
+  }
+  return (int)(envelope.next() * out) >> 8;
 }
 
 void loop() {
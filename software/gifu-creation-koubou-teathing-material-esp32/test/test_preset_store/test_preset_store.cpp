@@ -0,0 +1,182 @@
+/**
+ * @file test_preset_store.cpp
+ * @brief PresetStore against the file backed flash emulator, run with `pio test -e native`
+ *
+ * @author Kazuki Saita <saita@kinoshita-lab.com>
+ *
+ * Copyright (c) 2022 Kinoshita Lab. All rights reserved.
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "PresetStore.h"
+
+using namespace gifu_creation_koubou_2022_synth;
+
+namespace {
+const char* kPath = "test_presets.bin";
+const size_t kSlotSize = sizeof(PresetStore::Record);
+
+Patch makePatch(const uint8_t seed) {
+  Patch patch;
+  memset(&patch, 0, sizeof(patch));
+  for (auto i = 0; i < Patch::kNumSteps; ++i) {
+    patch.seq_freqs[i] = 100 * seed + i;
+  }
+  patch.attack = seed;
+  patch.decay = seed + 1;
+  patch.release = seed + 2;
+  patch.sustain = seed + 3;
+  patch.lfo1_freq = seed + 4;
+  patch.lfo1_depth = seed + 5;
+  patch.lfo2_freq = seed + 6;
+  patch.lfo2_depth = seed + 7;
+  patch.bpm = 120;
+  return patch;
+}
+
+bool samePatch(const Patch& a, const Patch& b) {
+  return memcmp(&a, &b, sizeof(Patch)) == 0;
+}
+
+// stores slots 0 to 2 and commits them to the file
+void storeThree() {
+  FilePresetStorage storage(kPath, kSlotSize);
+  PresetStore store(storage);
+  TEST_ASSERT_TRUE(store.begin());
+  for (auto i = 0; i < 3; ++i) {
+    store.store(i, makePatch(i + 1));
+  }
+  store.commit();
+  TEST_ASSERT_FALSE(store.isDirty());
+}
+
+// rewrites one record in the file, as a power cut or an old firmware would have left it
+template <typename F>
+void tamper(const int slot, F change) {
+  FilePresetStorage storage(kPath, kSlotSize);
+  TEST_ASSERT_TRUE(storage.begin());
+  PresetStore::Record record;
+  TEST_ASSERT_TRUE(storage.read(slot, &record, sizeof(record)));
+  change(record);
+  TEST_ASSERT_TRUE(storage.write(slot, &record, sizeof(record)));
+}
+
+// only the tampered slot is lost
+void checkOnlyLost(const int lost_slot) {
+  FilePresetStorage storage(kPath, kSlotSize);
+  PresetStore store(storage);
+  TEST_ASSERT_TRUE(store.begin());
+  for (auto i = 0; i < 3; ++i) {
+    Patch patch;
+    if (i == lost_slot) {
+      TEST_ASSERT_FALSE(store.recall(i, patch));
+    } else {
+      TEST_ASSERT_TRUE(store.recall(i, patch));
+      TEST_ASSERT_TRUE(samePatch(makePatch(i + 1), patch));
+    }
+  }
+}
+}  // namespace
+
+void setUp() {
+  remove(kPath);
+}
+
+void tearDown() {
+  remove(kPath);
+}
+
+void test_empty_flash_has_no_presets() {
+  FilePresetStorage storage(kPath, kSlotSize);
+  PresetStore store(storage);
+  TEST_ASSERT_TRUE(store.begin());
+  for (auto i = 0; i < PresetStore::kNumPresets; ++i) {
+    Patch patch;
+    TEST_ASSERT_FALSE(store.recall(i, patch));
+  }
+}
+
+void test_presets_survive_a_restart() {
+  storeThree();
+  checkOnlyLost(-1);
+
+  FilePresetStorage storage(kPath, kSlotSize);
+  PresetStore store(storage);
+  TEST_ASSERT_TRUE(store.begin());
+  Patch patch;
+  TEST_ASSERT_FALSE(store.recall(3, patch));
+}
+
+void test_bad_magic_is_recovered_as_empty() {
+  storeThree();
+  tamper(1, [](PresetStore::Record& record) { record.magic = 0; });
+  checkOnlyLost(1);
+}
+
+void test_old_version_is_recovered_as_empty() {
+  storeThree();
+  tamper(2, [](PresetStore::Record& record) { record.version = PresetStore::kVersion + 1; });
+  checkOnlyLost(2);
+}
+
+void test_bad_size_is_recovered_as_empty() {
+  storeThree();
+  tamper(0, [](PresetStore::Record& record) { record.size = sizeof(Patch) - 1; });
+  checkOnlyLost(0);
+}
+
+void test_bad_checksum_is_recovered_as_empty() {
+  storeThree();
+  tamper(1, [](PresetStore::Record& record) { record.patch.attack ^= 1; });
+  checkOnlyLost(1);
+}
+
+void test_a_lost_slot_can_be_stored_again() {
+  storeThree();
+  tamper(1, [](PresetStore::Record& record) { record.checksum ^= 0xffff; });
+  {
+    FilePresetStorage storage(kPath, kSlotSize);
+    PresetStore store(storage);
+    TEST_ASSERT_TRUE(store.begin());
+    store.store(1, makePatch(2));
+    store.commit();
+  }
+  checkOnlyLost(-1);
+}
+
+void test_commit_writes_only_changed_slots() {
+  FilePresetStorage storage(kPath, kSlotSize);
+  PresetStore store(storage);
+  TEST_ASSERT_TRUE(store.begin());
+
+  store.store(0, makePatch(1));
+  store.store(5, makePatch(6));
+  store.commit();
+  TEST_ASSERT_EQUAL(2, storage.writeCount());
+
+  // the same patch again does not make the slot dirty
+  store.store(0, makePatch(1));
+  TEST_ASSERT_FALSE(store.isDirty());
+  store.commit();
+  TEST_ASSERT_EQUAL(2, storage.writeCount());
+
+  store.store(5, makePatch(7));
+  TEST_ASSERT_TRUE(store.isDirty());
+  store.commit();
+  TEST_ASSERT_EQUAL(3, storage.writeCount());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_flash_has_no_presets);
+  RUN_TEST(test_presets_survive_a_restart);
+  RUN_TEST(test_bad_magic_is_recovered_as_empty);
+  RUN_TEST(test_old_version_is_recovered_as_empty);
+  RUN_TEST(test_bad_size_is_recovered_as_empty);
+  RUN_TEST(test_bad_checksum_is_recovered_as_empty);
+  RUN_TEST(test_a_lost_slot_can_be_stored_again);
+  RUN_TEST(test_commit_writes_only_changed_slots);
+  return UNITY_END();
+}